@@ -0,0 +1,47 @@
+-- Status effects: one AoE burn over many enemies, then the batched ticks.
+-- love . --bench effects [enemies] [ticks]
+local Bench = require("bench")
+local Effects = require("core.effects")
+local Enemy = require("entities.enemy")
+
+local suite = {}
+
+function suite.run(args)
+    local count = tonumber(args[3]) or 10000
+    local ticks = tonumber(args[4]) or 200
+
+    love.math.setRandomSeed(1)
+    local enemies = {}
+    for i = 1, count do
+        local e = Enemy.new(love.math.random() * 20, love.math.random() * 20)
+        e.hp = math.huge  -- keep every burn alive for the whole run
+        enemies[i] = e
+    end
+
+    local effects = Effects.new()
+
+    local start = love.timer.getTime()
+    local applied = effects:applyArea("burn", 10, 10, 30, enemies)
+    local applyMs = (love.timer.getTime() - start) * 1000
+    print(string.format("applyArea: %d burns in %.3f ms", applied, applyMs))
+
+    -- Refreshing existing burns is the common case in a fight
+    local refreshMs = Bench.time(function()
+        effects:applyArea("burn", 10, 10, 30, enemies)
+    end, 20, 2)
+    print(string.format("re-apply:  %.3f ms", refreshMs))
+
+    local tickMs = Bench.time(function()
+        effects:tick()
+        -- Top the durations back up so the set never shrinks
+        for i = 1, effects.count do effects.ticks[i] = 8 end
+    end, ticks, 10)
+    print(string.format("tick:      %.3f ms per tick (%d active)  %.1f ns/effect",
+        tickMs, effects.count, tickMs * 1e6 / math.max(effects.count, 1)))
+
+    -- A tick lands on one frame every TICK seconds
+    print(string.format("at 60 Hz: +%.3f ms on tick frames, %.3f ms/frame amortized",
+        tickMs, tickMs / (Effects.TICK * 60)))
+end
+
+return suite
@@ -0,0 +1,88 @@
+-- Enemy:update, generic path vs the archetype-compiled one.
+-- Two identical crowds (same seed) run the same ticks; the final states
+-- must match or the compiled version has drifted from the generic one.
+-- love . --bench enemy_update [enemies] [ticks]
+local Bench = require("bench")
+local Enemy = require("entities.enemy")
+local Archetypes = require("core.archetypes")
+local ArchetypeCompiler = require("core.archetype_compiler")
+
+local suite = {}
+
+local DT = 1 / 60
+
+-- Mostly idle, with a share mid-hit and a few dying, re-hit periodically
+local function crowd(count)
+    love.math.setRandomSeed(7)
+    local enemies = {}
+    for i = 1, count do
+        local e = Enemy.new(love.math.random() * 25, love.math.random() * 25)
+        e.hp = math.huge
+        enemies[i] = e
+    end
+    return enemies
+end
+
+local function stir(enemies, tick)
+    for i = (tick % 7) + 1, #enemies, 7 do
+        local e = enemies[i]
+        if i % 20 == 0 then
+            e.hp = 0
+            e:takeDamage(1)
+        elseif not e.dead then
+            e:takeDamage(1)
+        end
+    end
+end
+
+local function run(update, enemies, ticks, player)
+    return Bench.time(function()
+        for i = 1, #enemies do update(enemies[i], DT, player) end
+    end, ticks, 0)
+end
+
+local function same(a, b)
+    local x, y = a.anim, b.anim
+    return x.name == y.name and x.frame == y.frame and x.playing == y.playing
+        and math.abs(x.timer - y.timer) < 1e-9 and a.isHit == b.isHit
+        and a.deathAnimComplete == b.deathAnimComplete
+        and a.facingX == b.facingX and a.facingY == b.facingY
+end
+
+function suite.run(args)
+    local count = tonumber(args[3]) or 10000
+    local ticks = tonumber(args[4]) or 300
+    local player = { x = 12.5, y = 12.5 }
+
+    local generic = Enemy.genericUpdate or Enemy.update
+    local compiled = ArchetypeCompiler.compile(Archetypes.enemy)
+
+    local a, b = crowd(count), crowd(count)
+    local genericMs, compiledMs = 0, 0
+
+    -- Interleave in slices so both paths see the same mix of states
+    local slice = 30
+    for t = 0, ticks - 1, slice do
+        stir(a, t)
+        stir(b, t)
+        local n = math.min(slice, ticks - t)
+        genericMs = genericMs + run(generic, a, n, player) * n
+        compiledMs = compiledMs + run(compiled, b, n, player) * n
+    end
+
+    local mismatches = 0
+    for i = 1, count do
+        if not same(a[i], b[i]) then mismatches = mismatches + 1 end
+    end
+
+    print(string.format("generic:  %.3f ms/tick  %.1f ns/enemy",
+        genericMs / ticks, genericMs * 1e6 / (ticks * count)))
+    print(string.format("compiled: %.3f ms/tick  %.1f ns/enemy  (%.2fx)",
+        compiledMs / ticks, compiledMs * 1e6 / (ticks * count),
+        genericMs / math.max(compiledMs, 1e-9)))
+    print(string.format("state mismatches: %d / %d", mismatches, count))
+
+    return mismatches > 0 and 1 or 0
+end
+
+return suite
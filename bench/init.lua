@@ -0,0 +1,27 @@
+-- Benchmarks that need a running LÖVE (threads, graphics, audio).
+-- Usage: love . --bench <name> [args...]
+-- Module-level micro-benchmarks run without LÖVE: see bench/micro/run.lua.
+-- A suite may return an exit status; non-zero fails the process (CI).
+local Bench = {}
+
+function Bench.run(name, args)
+    if not name then
+        print("usage: love . --bench <name> [args...]")
+        return
+    end
+
+    local suite = require("bench." .. name)
+    print(string.format("== bench %s ==", name))
+    return suite.run(args or {})
+end
+
+-- Time `fn` over `ticks` calls after `warmup` untimed calls; returns ms/call
+function Bench.time(fn, ticks, warmup)
+    for _ = 1, warmup or 0 do fn() end
+
+    local start = love.timer.getTime()
+    for _ = 1, ticks do fn() end
+    return (love.timer.getTime() - start) * 1000 / ticks
+end
+
+return Bench
@@ -0,0 +1,212 @@
+-- Micro-benchmark cases for bench/micro/run.lua.
+-- Each case is { name, setup, maxOps }: setup() builds whatever state it
+-- needs and returns run(n), which performs the operation n times. Keep
+-- setup out of run() so only the operation itself is timed and counted.
+-- maxOps caps the batch size for operations that take milliseconds.
+local Iso = require("core.iso")
+local Room = require("world.room")
+local Archetypes = require("core.archetypes")
+local Effects = require("core.effects")
+local Enemy = require("entities.enemy")
+local Player = require("entities.player")
+local ArchetypeCompiler = require("core.archetype_compiler")
+
+local TILE_W, TILE_H = 150, 96
+local DT = 1 / 60
+
+local NullAudio = { play = function() end }
+
+local function room()
+    love.math.setRandomSeed(1)
+    local r = Room.new(25, 25)
+    r:generate()
+    return r
+end
+
+local function crowd(count, r)
+    love.math.setRandomSeed(2)
+    local enemies = {}
+    for i = 1, count do
+        local x, y = r:getRandomTile()
+        local e = Enemy.new(x, y)
+        e.hp = math.huge  -- nothing dies, so every op sees the same crowd
+        enemies[i] = e
+    end
+    return enemies
+end
+
+-- Knock a rotating seventh of the crowd into hit, and every 20th into
+-- death, so updates exercise the one-shot clips and not just idle
+-- (same mix as bench/enemy_update.lua)
+local STIR_EVERY = 30
+
+local function stir(enemies, tick)
+    for i = (tick % 7) + 1, #enemies, 7 do
+        local e = enemies[i]
+        if i % 20 == 0 then
+            e.hp = 0
+            e:takeDamage(1)
+        elseif not e.dead then
+            e:takeDamage(1)
+        end
+    end
+end
+
+-- Crowd updates with stirring; the stir is a small share of each op
+local function crowdUpdate(update)
+    local r = room()
+    local enemies, player = crowd(1000, r), Player.new(12.5, 12.5)
+    local tick = 0
+    return function(n)
+        for _ = 1, n do
+            if tick % STIR_EVERY == 0 then stir(enemies, tick) end
+            tick = tick + 1
+            for i = 1, #enemies do update(enemies[i], DT, player) end
+        end
+    end
+end
+
+-- Player in the middle of a 500-enemy crowd, weapon ready
+local function arena()
+    local r = room()
+    local player = Player.new(12.5, 12.5)
+    return r, player, crowd(500, r)
+end
+
+local cases = {}
+
+local function case(name, setup, maxOps)
+    cases[#cases + 1] = { name = name, setup = setup, maxOps = maxOps }
+end
+
+-- core/iso -----------------------------------------------------------------
+
+case("iso.project", function()
+    local project = Iso.project
+    return function(n)
+        local sum = 0
+        for i = 1, n do
+            local sx, sy = project(i * 0.01, i * 0.02, TILE_W, TILE_H)
+            sum = sum + sx + sy
+        end
+        return sum
+    end
+end)
+
+case("iso.screenToWorld", function()
+    local toWorld = Iso.screenToWorld
+    return function(n)
+        local sum = 0
+        for i = 1, n do
+            local x, y = toWorld(i * 0.5, i * 0.25, TILE_W, TILE_H)
+            sum = sum + x + y
+        end
+        return sum
+    end
+end)
+
+-- world/room ---------------------------------------------------------------
+
+case("room.generate 25x25", function()
+    local r = Room.new(25, 25)
+    return function(n)
+        for _ = 1, n do r:generate() end
+    end
+end)
+
+case("room.isWalkable", function()
+    local r = room()
+    return function(n)
+        local count = 0
+        for i = 1, n do
+            if r:isWalkable((i * 7) % 27 - 1, (i * 13) % 27 - 1) then count = count + 1 end
+        end
+        return count
+    end
+end)
+
+case("room.getRandomTile", function()
+    local r = room()
+    return function(n)
+        for _ = 1, n do r:getRandomTile() end
+    end
+end)
+
+-- weapons/mace (500 enemies around the player) -----------------------------
+
+case("mace.primary x500", function()
+    local _, player, enemies = arena()
+    local mace = player.weapon
+    return function(n)
+        for _ = 1, n do
+            mace.cooldown = 0
+            mace:primary(enemies)
+            for i = #mace.pendingDamage, 1, -1 do mace.pendingDamage[i] = nil end
+        end
+    end
+end)
+
+case("mace.secondary x500", function()
+    local _, player, enemies = arena()
+    local mace, effects = player.weapon, Effects.new()
+    return function(n)
+        for _ = 1, n do
+            mace.cooldown = 0
+            mace:secondary(enemies, effects)
+            for i = #mace.pendingDamage, 1, -1 do mace.pendingDamage[i] = nil end
+            for i = #mace.pendingAreas, 1, -1 do mace.pendingAreas[i] = nil end
+        end
+    end
+end)
+
+-- One sweep's worth of hits resolved per op (queue refilled each time)
+case("mace.processPendingDamage", function()
+    local _, player, enemies = arena()
+    local mace = player.weapon
+    local delay = Archetypes.mace.sweep.duration * Archetypes.mace.damageDelay
+    return function(n)
+        for _ = 1, n do
+            for i = 1, 64 do mace:queueDamage(enemies[i], 0, delay) end
+            mace:processPendingDamage(delay, {}, NullAudio)
+        end
+    end
+end)
+
+-- entity construction (per-instance footprint, see core/archetypes) -------
+
+-- alloc B/op is the size of one enemy's own state
+case("enemy.new", function()
+    local keep = {}
+    return function(n)
+        for i = 1, n do keep[i] = Enemy.new(i % 25, i % 23) end
+    end
+end)
+
+-- Full collection with 10k live enemies: what a breakpoint GC costs
+case("gc full, 10k enemies live", function()
+    local r = room()
+    local enemies = crowd(10000, r)
+    return function(n)
+        for _ = 1, n do collectgarbage("collect") end
+        return enemies
+    end
+end, 5)
+
+-- entity updates -----------------------------------------------------------
+
+case("enemy.update generic x1000", function()
+    return crowdUpdate(Enemy.genericUpdate or Enemy.update)
+end)
+
+case("enemy.update compiled x1000", function()
+    return crowdUpdate(ArchetypeCompiler.compile(Archetypes.enemy))
+end)
+
+case("player.update", function()
+    local r, player = arena()
+    return function(n)
+        for _ = 1, n do player:update(DT, r, {}, NullAudio) end
+    end
+end)
+
+return cases
@@ -0,0 +1,69 @@
+-- Micro-benchmarks for core modules under plain LuaJIT, no window.
+-- Run from the game directory:
+--   luajit bench/micro/run.lua [pattern] [--warmup N] [--reps N] [--ops N]
+-- pattern is a Lua pattern matched against case names (all by default).
+-- Each case runs `warmup` untimed batches, then `reps` timed batches of
+-- `ops` operations; ns/op is reported as the median and best batch.
+-- alloc/op is measured on a separate batch with the GC stopped.
+package.path = "./?.lua;./?/init.lua;" .. package.path
+
+require("bench.micro.stubs").install()
+
+local args = arg or {}
+local opts = { warmup = 3, reps = 10, ops = 1000 }
+local pattern = nil
+
+local i = 1
+while i <= #args do
+    local a = args[i]
+    local key = a:match("^%-%-(%a+)$")
+    if key and opts[key] then
+        opts[key] = assert(tonumber(args[i + 1]), a .. " needs a number")
+        i = i + 1
+    else
+        pattern = a
+    end
+    i = i + 1
+end
+
+local getTime = love.timer.getTime
+local cases = require("bench.micro.cases")
+
+-- ops: batch size, capped by the case's maxOps for slow operations
+local function measure(run, ops)
+    for _ = 1, opts.warmup do run(ops) end
+
+    local samples = {}
+    for r = 1, opts.reps do
+        local start = getTime()
+        run(ops)
+        samples[r] = (getTime() - start) * 1e9 / ops
+    end
+    table.sort(samples)
+
+    collectgarbage("collect")
+    collectgarbage("stop")
+    local before = collectgarbage("count")
+    run(ops)
+    local bytes = (collectgarbage("count") - before) * 1024 / ops
+    collectgarbage("restart")
+
+    return samples[math.ceil(#samples / 2)], samples[1], bytes
+end
+
+print(string.format("warmup %d  reps %d  ops %d", opts.warmup, opts.reps, opts.ops))
+print(string.format("%-32s %14s %14s %12s", "case", "ns/op (med)", "ns/op (best)", "alloc B/op"))
+
+local ran = 0
+for _, c in ipairs(cases) do
+    if not pattern or c.name:find(pattern) then
+        local median, best, bytes = measure(c.setup(), math.min(opts.ops, c.maxOps or opts.ops))
+        print(string.format("%-32s %14.1f %14.1f %12.1f", c.name, median, best, bytes))
+        ran = ran + 1
+    end
+end
+
+if ran == 0 then
+    print("no cases match " .. tostring(pattern))
+    os.exit(1)
+end
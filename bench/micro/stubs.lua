@@ -0,0 +1,117 @@
+-- Just enough of `love` for game modules to load and run under plain
+-- LuaJIT: love.math, love.graphics, love.audio and the bits of
+-- filesystem/timer/input they touch. Objects (images, quads, sources)
+-- are inert; unknown methods are no-ops.
+local Stubs = {}
+
+local noop = function() end
+
+-- Inert object: explicit getters, anything else is a no-op method
+local function object(w, h, extra)
+    local o = extra or {}
+    o.getWidth = function() return w end
+    o.getHeight = function() return h end
+    o.getDimensions = function() return w, h end
+    o.getPixelDimensions = function() return w, h end
+    o.getViewport = function() return 0, 0, w, h end
+    o.getFormat = function() return "rgba8" end
+    o.getLayerCount = function() return 1 end
+    o.getDepth = function() return 1 end
+    o.getMipmapCount = function() return 1 end
+    o.getSize = function() return w * h end
+    o.isPlaying = function() return false end
+    return setmetatable(o, { __index = function() return noop end })
+end
+
+-- Smooth value noise in [0, 1]; stands in for love.math.noise
+local function hash(x, y)
+    local n = (x * 374761393 + y * 668265263) % 2147483647
+    n = (n * n * 15731 + 789221) % 2147483647
+    return n / 2147483647
+end
+
+local function noise(x, y)
+    y = y or 0
+    local x0, y0 = math.floor(x), math.floor(y)
+    local fx, fy = x - x0, y - y0
+    fx, fy = fx * fx * (3 - 2 * fx), fy * fy * (3 - 2 * fy)
+    local a = hash(x0, y0) + (hash(x0 + 1, y0) - hash(x0, y0)) * fx
+    local b = hash(x0, y0 + 1) + (hash(x0 + 1, y0 + 1) - hash(x0, y0 + 1)) * fx
+    return a + (b - a) * fy
+end
+
+-- Monotonic seconds; clock_gettime where ffi has it, os.clock otherwise
+local function clock()
+    local ok, ffi = pcall(require, "ffi")
+    if ok and ffi.os ~= "Windows" then
+        local ts = pcall(ffi.cdef, [[
+            typedef struct { long tv_sec; long tv_nsec; } bench_timespec;
+            int clock_gettime(int clk, bench_timespec *ts);
+        ]]) and ffi.new("bench_timespec")
+        if ts then
+            return function()
+                ffi.C.clock_gettime(1, ts)  -- CLOCK_MONOTONIC
+                return tonumber(ts.tv_sec) + tonumber(ts.tv_nsec) * 1e-9
+            end
+        end
+    end
+    return os.clock
+end
+
+function Stubs.install()
+    local getTime = clock()
+
+    love = {
+        math = {
+            random = function(a, b)
+                if a then return math.random(a, b) end
+                return math.random()
+            end,
+            setRandomSeed = function(seed) math.randomseed(seed) end,
+            noise = noise,
+        },
+        graphics = setmetatable({
+            getWidth = function() return 1280 end,
+            getHeight = function() return 720 end,
+            getDimensions = function() return 1280, 720 end,
+            newImage = function() return object(1024, 1024) end,
+            newCanvas = function(w, h) return object(w or 1280, h or 720) end,
+            newQuad = function(x, y, w, h) return object(w, h) end,
+            newFont = function() return object(0, 14) end,
+            newMesh = function() return object(0, 0) end,
+            newSpriteBatch = function() return object(0, 0) end,
+        }, { __index = function() return noop end }),
+        audio = setmetatable({
+            newSource = function()
+                local src
+                src = object(0, 0, { clone = function() return src end })
+                return src
+            end,
+        }, { __index = function() return noop end }),
+        sound = {
+            newSoundData = function() return object(44100, 2) end,
+        },
+        filesystem = {
+            getInfo = function(path)
+                local f = io.open(path, "rb")
+                if not f then return nil end
+                f:close()
+                return { type = "file" }
+            end,
+            newFileData = function(contents, name)
+                return object(0, 0, { getFilename = function() return name or contents end })
+            end,
+            write = noop,
+        },
+        timer = {
+            getTime = getTime,
+            getDelta = function() return 1 / 60 end,
+            getFPS = function() return 60 end,
+        },
+        keyboard = { isDown = function() return false end },
+        mouse = { getPosition = function() return 640, 360 end },
+    }
+    return love
+end
+
+return Stubs
@@ -0,0 +1,48 @@
+-- Scaling of ParallelSim across worker counts (crowd taking hits and deaths).
+-- love . --bench parallel_sim [entities] [ticks]
+local Bench = require("bench")
+local Archetypes = require("core.archetypes")
+local ParallelSim = require("core.parallel_sim")
+
+local suite = {}
+
+local CORE_COUNTS = { 1, 2, 4, 8, 16 }
+
+function suite.run(args)
+    local count = tonumber(args[3]) or 50000
+    local ticks = tonumber(args[4]) or 600
+    local dt = 1 / 60
+
+    print(string.format("%d entities, %d ticks, %d logical cores",
+        count, ticks, love.system.getProcessorCount()))
+
+    local baseline
+    for _, cores in ipairs(CORE_COUNTS) do
+        -- One core means the main thread runs the kernel inline
+        local sim = ParallelSim.new(Archetypes.enemy, count, cores > 1 and cores or 0)
+
+        love.math.setRandomSeed(1)
+        for _ = 1, count do
+            local i = sim:add(love.math.random() * 100, love.math.random() * 100)
+            sim:entity(i).animTimer = love.math.random() * 0.15
+        end
+
+        -- Same mix as bench/enemy_update: every 30 ticks a rotating
+        -- seventh is hit, every 20th of those killed
+        local tick = 0
+        local ms = Bench.time(function()
+            if tick % 30 == 0 then
+                for i = tick % 7, count - 1, 7 do sim:hit(i, i % 20 == 0) end
+            end
+            tick = tick + 1
+            sim:step(dt, 50, 50)
+        end, ticks, 60)
+        baseline = baseline or ms
+        print(string.format("cores %2d: %7.3f ms/tick  %5.2fx  %6.1f ns/entity",
+            cores, ms, baseline / ms, ms * 1e6 / count))
+
+        sim:release()
+    end
+end
+
+return suite
@@ -0,0 +1,217 @@
+-- Render regression benchmark: floor, fog, walls, N enemies and particles drawn
+-- through the render queue into an offscreen canvas. Runs fine under a
+-- software rasterizer (Mesa llvmpipe, see tools/ci_render_bench.sh).
+-- Draw calls and state changes are deterministic and must not exceed the
+-- recorded baseline; frame time and texture memory get a tolerance.
+-- love . --bench render [enemies] [frames] [--record] [--ci]
+-- With --ci a missing baseline is a failure rather than a note, so CI
+-- cannot pass without one being committed.
+local Bench = require("bench")
+local Room = require("world.room")
+local Floor = require("world.floor")
+local Visibility = require("world.visibility")
+local Walls = require("world.walls")
+local Enemy = require("entities.enemy")
+local Iso = require("core.iso")
+local RenderQueue = require("core.render_queue")
+local Quality = require("core.quality")
+local AnimClock = require("core.anim_clock")
+
+local suite = {}
+
+local BASELINE = "bench/render_baseline.txt"
+local W, H = 1280, 720
+local TILE_W, TILE_H = 150, 96
+local PARTICLES = 2000
+
+-- Metrics checked against the baseline: exact for counts, a ratio
+-- tolerance for the noisy ones
+local CHECKS = {
+    { key = "drawcalls", tolerance = 0 },
+    { key = "textureChanges", tolerance = 0 },
+    { key = "shaderswitches", tolerance = 0 },
+    { key = "canvasswitches", tolerance = 0 },
+    { key = "textureMB", tolerance = 0.05 },
+    { key = "frameMs", tolerance = 0.5 },
+}
+
+local function loadBaseline()
+    local contents = love.filesystem.read(BASELINE)
+    if not contents then return nil end
+
+    local values = {}
+    for key, value in contents:gmatch("(%w+)=([^\n]*)") do
+        values[key] = tonumber(value)
+    end
+    return values
+end
+
+-- The save directory can't write into the game source, so go through io
+local function saveBaseline(result)
+    local lines = {}
+    for _, c in ipairs(CHECKS) do
+        table.insert(lines, string.format("%s=%s", c.key, tostring(result[c.key])))
+    end
+
+    local path = love.filesystem.getSource() .. "/" .. BASELINE
+    local f = assert(io.open(path, "w"))
+    f:write(table.concat(lines, "\n"), "\n")
+    f:close()
+    print("recorded baseline to " .. path)
+end
+
+local function buildScene(count)
+    love.math.setRandomSeed(1)
+
+    local room = Room.new(25, 25)
+    room:generate()
+
+    local floor = Floor.new(room, TILE_W, TILE_H, Quality.settings.floorMode)
+    local visibility = Visibility.new(room)
+    floor:setVisibility(visibility)
+
+    local cx, cy = room:getRandomTile()
+    visibility:update(cx, cy)
+
+    local walls = Walls.new(room, TILE_W, TILE_H, visibility)
+
+    local enemies = {}
+    for i = 1, count do
+        enemies[i] = Enemy.new(room:getRandomTile())
+    end
+
+    local dot = love.image.newImageData(8, 8)
+    dot:mapPixel(function() return 1, 1, 1, 1 end)
+    local particles = love.graphics.newParticleSystem(love.graphics.newImage(dot), PARTICLES)
+    particles:setParticleLifetime(2, 4)
+    particles:setEmissionArea("uniform", W / 2, H / 2)
+    particles:setSizes(2, 4)
+    particles:setColors(1, 0.3, 0.1, 0.6, 1, 0.8, 0.2, 0)
+    particles:emit(PARTICLES)
+
+    local sx, sy = Iso.project(cx, cy, TILE_W, TILE_H)
+    local view = { x = W / 2 - sx, y = H / 2 - sy, viewX = 0, viewY = 0, viewW = W, viewH = H }
+
+    return {
+        floor = floor,
+        walls = walls,
+        enemies = enemies,
+        particles = particles,
+        particleX = sx,
+        particleY = sy,
+        target = { x = cx, y = cy },
+        views = { view },
+        queue = RenderQueue.new(),
+    }
+end
+
+local function iso(x, y)
+    return Iso.project(x, y, TILE_W, TILE_H)
+end
+
+local function drawFrame(scene, canvas)
+    local queue = scene.queue
+    local dt = 1 / 60
+
+    AnimClock.update(dt)
+    for _, e in ipairs(scene.enemies) do e:update(dt, scene.target) end
+    scene.particles:update(dt)
+
+    love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 1)
+
+    queue:begin()
+    scene.floor:draw(queue)
+    scene.walls:draw(queue)
+    for _, e in ipairs(scene.enemies) do e:draw(iso, queue) end
+    queue:setColor(1, 1, 1, 1)
+    queue:sprite(RenderQueue.LAYER_OVERLAY, 0, scene.particles, nil, scene.particleX, scene.particleY)
+    queue:flush(scene.views)
+
+    love.graphics.setCanvas()
+end
+
+function suite.run(args)
+    local count, frames = 200, 120
+    local record, ci = false, false
+    local positional = {}
+    for i = 3, #args do
+        if args[i] == "--record" then
+            record = true
+        elseif args[i] == "--ci" then
+            ci = true
+        else
+            table.insert(positional, tonumber(args[i]))
+        end
+    end
+    count = positional[1] or count
+    frames = positional[2] or frames
+
+    -- Fixed tier so the scene doesn't depend on the machine
+    Quality.set("high")
+
+    print(string.format("renderer: %s", table.concat({ love.graphics.getRendererInfo() }, " / ")))
+    print(string.format("%d enemies, %d particles, %d frames at %dx%d", count, PARTICLES, frames, W, H))
+
+    local canvas = love.graphics.newCanvas(W, H)
+    local scene = buildScene(count)
+
+    -- getStats counts since the last present, so present between frames
+    local result
+    local frameMs = Bench.time(function()
+        love.graphics.present()
+        drawFrame(scene, canvas)
+    end, frames, 10)
+
+    -- Wait for the GPU (or llvmpipe) before trusting the timing
+    local start = love.timer.getTime()
+    canvas:newImageData(1, 1, 0, 0, 1, 1):release()
+    frameMs = frameMs + (love.timer.getTime() - start) * 1000 / frames
+
+    local gs = love.graphics.getStats()
+    result = {
+        frameMs = frameMs,
+        drawcalls = gs.drawcalls,
+        shaderswitches = gs.shaderswitches,
+        canvasswitches = gs.canvasswitches,
+        textureMB = gs.texturememory / (1024 * 1024),
+        textureChanges = scene.queue.stats.textureChanges,
+    }
+
+    print(string.format("frame %.3f ms  draw calls %d (batched %d)  texture changes %d",
+        result.frameMs, result.drawcalls, gs.drawcallsbatched, result.textureChanges))
+    print(string.format("shader switches %d  canvas switches %d  texture memory %.1f MB",
+        result.shaderswitches, result.canvasswitches, result.textureMB))
+
+    if record then
+        saveBaseline(result)
+        return 0
+    end
+
+    local baseline = loadBaseline()
+    if not baseline then
+        print("no baseline at " .. BASELINE .. "; run with --record to create one")
+        return ci and 1 or 0
+    end
+
+    local failed = 0
+    for _, c in ipairs(CHECKS) do
+        local base, value = baseline[c.key], result[c.key]
+        if base then
+            local limit = base * (1 + c.tolerance)
+            local status = value <= limit and "ok" or "REGRESSION"
+            if value > limit then failed = failed + 1 end
+            print(string.format("  %-15s %10.3f  baseline %10.3f  limit %10.3f  %s",
+                c.key, value, base, limit, status))
+        end
+    end
+
+    if failed > 0 then
+        print(string.format("%d metric(s) regressed", failed))
+        return 1
+    end
+    print("no regressions")
+    return 0
+end
+
+return suite
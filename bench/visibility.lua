@@ -0,0 +1,45 @@
+-- Shadowcasting recompute time by view radius.
+-- love . --bench visibility [roomSize] [ticks]
+local Bench = require("bench")
+local Room = require("world.room")
+local Visibility = require("world.visibility")
+
+local suite = {}
+
+local RADII = { 4, 8, 16, 32, 64, 128 }
+
+function suite.run(args)
+    local size = tonumber(args[3]) or 300
+    local ticks = tonumber(args[4]) or 200
+
+    love.math.setRandomSeed(1)
+    local room = Room.new(size, size)
+    room:generate()
+
+    -- Sprinkle pillars so octants actually split and recurse
+    for _ = 1, size * size / 20 do
+        room:setWalkable(love.math.random(1, size), love.math.random(1, size), false)
+    end
+
+    local cx, cy = math.floor(size / 2), math.floor(size / 2)
+    room:setWalkable(cx, cy, true)
+
+    print(string.format("%dx%d room, %d ticks", size, size, ticks))
+
+    for _, radius in ipairs(RADII) do
+        local vis = Visibility.new(room, radius)
+        local ms = Bench.time(function() vis:compute(cx, cy) end, ticks, 20)
+
+        local lit = 0
+        for y = cy - radius, cy + radius do
+            for x = cx - radius, cx + radius do
+                if vis:isVisible(x, y) then lit = lit + 1 end
+            end
+        end
+
+        print(string.format("radius %3d: %8.4f ms/recompute  %6d tiles lit  %6.1f ns/tile",
+            radius, ms, lit, ms * 1e6 / math.max(lit, 1)))
+    end
+end
+
+return suite
@@ -0,0 +1,38 @@
+-- Shared clocks for looping animation clips.
+-- Each looping clip (an archetype anims entry) has one clock, advanced
+-- once per frame and wrapped to the clip's period. Entities in a looping
+-- clip store only a phase offset and derive their frame when drawn, so
+-- a crowd idling or running costs nothing per entity per update.
+-- One-shot clips (hit, death, attacks) keep per-entity timers.
+local AnimClock = {}
+
+local clocks = {}  -- clip -> seconds into its period
+
+local function period(clip)
+    return clip.frames * clip.speed
+end
+
+function AnimClock.update(dt)
+    for clip, t in pairs(clocks) do
+        clocks[clip] = (t + dt) % period(clip)
+    end
+end
+
+-- Phase that puts `clip` on frame 1 right now, plus `offset` seconds
+function AnimClock.phaseFor(clip, offset)
+    local t = clocks[clip]
+    if not t then
+        t = 0
+        clocks[clip] = t
+    end
+    return ((offset or 0) - t) % period(clip)
+end
+
+-- Current frame (1-based) of `clip` for an entity with `phase`
+function AnimClock.frame(clip, phase)
+    local t = ((clocks[clip] or 0) + phase) % period(clip)
+    local frame = math.floor(t / clip.speed) + 1
+    return frame > clip.frames and clip.frames or frame
+end
+
+return AnimClock
@@ -0,0 +1,111 @@
+-- Archetype compiler.
+-- Generates an update function specialised to one archetype as Lua
+-- source and load()s it, with the archetype's constants (frame counts,
+-- speeds, hit flash, clip transitions) folded in as literals and only
+-- the one-shot clips it actually has emitted as branches. LuaJIT traces
+-- these into tight loops where the generic Enemy:update keeps looking up
+-- tables and testing flags. Looping clips need no update code at all
+-- (see core/anim_clock.lua).
+local ArchetypeCompiler = {}
+
+-- --generic-update keeps the generic path (A/B against the compiled one)
+ArchetypeCompiler.enabled = true
+
+function ArchetypeCompiler.configure(args)
+    for i = 1, #(args or {}) do
+        if args[i] == "--generic-update" then
+            ArchetypeCompiler.enabled = false
+        end
+    end
+end
+
+local function num(v)
+    return string.format("%.17g", v)
+end
+
+-- Lua source of the update function for `arch`
+function ArchetypeCompiler.source(arch)
+    local out = {}
+    local function emit(fmt, ...) out[#out + 1] = string.format(fmt, ...) end
+
+    emit("-- generated by core/archetype_compiler.lua for archetype %q", arch.name)
+    emit("local sqrt = math.sqrt")
+    emit("return function(self, dt, player)")
+
+    -- Facing: always on for enemies
+    emit("    if player then")
+    emit("        local dx, dy = player.x - self.x, player.y - self.y")
+    emit("        local len = sqrt(dx * dx + dy * dy)")
+    emit("        if len > 0.001 then")
+    emit("            self.facingX = dx / len")
+    emit("            self.facingY = dy / len")
+    emit("        end")
+    emit("    end")
+
+    if arch.hitFlash then
+        emit("    if self.isHit then")
+        emit("        local flash = self.hitFlash - dt")
+        emit("        self.hitFlash = flash")
+        emit("        if flash <= 0 then self.isHit = false end")
+        emit("    end")
+    end
+
+    -- One branch per one-shot clip, sorted for stable output
+    local names = {}
+    for name, a in pairs(arch.anims) do
+        if not a.loop then names[#names + 1] = name end
+    end
+    table.sort(names)
+
+    if #names > 0 then
+        emit("    local anim = self.anim")
+        emit("    if not anim.playing then return end")
+        emit("    local name = anim.name")
+
+        for i, name in ipairs(names) do
+            local a = arch.anims[name]
+            emit("    %s name == %q then", i == 1 and "if" or "elseif", name)
+            emit("        local t, f = anim.timer + dt, anim.frame")
+            emit("        while t >= %s do", num(a.speed))
+            emit("            t = t - %s", num(a.speed))
+            emit("            f = f + 1")
+            emit("            if f > %d then", a.frames)
+            emit("                anim.frame, anim.timer, anim.playing = %d, t, false", a.frames)
+            -- Same precedence as Enemy:update: `next` unless dead, else `completes`
+            if a.next and a.completes then
+                emit("                if not self.dead then self:setAnim(%q) else self.deathAnimComplete = true end", a.next)
+            elseif a.next then
+                emit("                if not self.dead then self:setAnim(%q) end", a.next)
+            elseif a.completes then
+                emit("                self.deathAnimComplete = true")
+            end
+            emit("                return")
+            emit("            end")
+            emit("        end")
+            emit("        anim.frame, anim.timer = f, t")
+        end
+        emit("    end")
+    end
+
+    emit("end")
+    return table.concat(out, "\n") .. "\n"
+end
+
+function ArchetypeCompiler.compile(arch)
+    local src = ArchetypeCompiler.source(arch)
+    local chunk, err = load(src, "=archetype:" .. arch.name)
+    if not chunk then
+        error("archetype compiler: " .. err .. "\n" .. src)
+    end
+    return chunk()
+end
+
+-- Replace class.update with the compiled version; the generic one stays
+-- available as class.genericUpdate
+function ArchetypeCompiler.install(class, arch)
+    class.genericUpdate = class.genericUpdate or class.update
+    class.update = ArchetypeCompiler.compile(arch)
+    return class.update
+end
+
+return ArchetypeCompiler
@@ -0,0 +1,145 @@
+-- Shared, read-only definitions for each kind of entity/weapon.
+-- Instances keep only their mutable state plus an `archetype` reference,
+-- so thousands of enemies share one set of animation and tuning tables.
+local Archetypes = {}
+
+Archetypes.player = {
+    name = "player",
+
+    -- scale (tweak later)
+    spriteScale = 1.2,
+
+    -- animation definitions (frames per animation)
+    -- Frame counts match the grid layouts defined in ANIM_GRID_LAYOUTS
+    -- Speed is time per frame in seconds (higher = slower animation)
+    anims = {
+        idle = {
+            frames = 16,   -- 4x4 = 16 frames
+            speed = 0.2,   -- 0.2s per frame = 3.2s total cycle
+            loop = true    -- Continuously loop
+        },
+        walk = {
+            frames = 20,   -- 5x4 = 20 frames
+            speed = 0.08,  -- 0.08s per frame = 1.6s total cycle
+            loop = true    -- Continuously loop
+        },
+        run = {
+            frames = 16,   -- 4x4 = 16 frames (used for dash)
+            speed = 0.06,  -- 0.06s per frame = 0.96s total cycle
+            loop = true    -- Continuously loop
+        },
+        attack_swipe = {
+            frames = 20,   -- 5x4 = 20 frames (Attack_Swipe)
+            speed = 0.1,   -- 0.1s per frame = 2s total (slow sweep)
+            loop = false   -- Play once, then return to idle
+        },
+        attack_jump = {
+            frames = 24,   -- 6x4 = 24 frames (Attack_Jump)
+            speed = 0.1,   -- 0.1s per frame = 2.4s total (slow jump)
+            loop = false   -- Play once, then return to idle
+        }
+    },
+
+    speed = 3,
+    size = 15,
+
+    -- blob shadow under the feet (screen px from the sprite center)
+    shadowOffset = 75,
+    shadowRadius = 30,
+
+    -- dash
+    dashDuration = 0.15,
+    dashSpeed = 10,
+
+    -- Opaque bounding box of the idle frame (see Archetypes.enemy)
+    pickFrame = 256,
+    pickBounds = { 71, 70, 183, 195 },
+}
+
+Archetypes.enemy = {
+    name = "enemy",
+
+    spriteScale = 1.5,
+
+    anims = {
+        idle = {
+            frames = 20,   -- 5x4 = 20 frames
+            speed = 0.15,  -- 0.15s per frame
+            loop = true
+        },
+        hit = {
+            frames = 16,   -- 4x4 = 16 frames
+            speed = 0.05,  -- 0.05s per frame = 0.8s total (quick hit reaction)
+            loop = false,
+            next = "idle"  -- back to idle when it ends (unless dead)
+        },
+        death = {
+            frames = 30,   -- 6x5 = 30 frames
+            speed = 0.08,  -- 0.08s per frame = 2.4s total
+            loop = false,
+            completes = true  -- sets deathAnimComplete when it ends
+        }
+    },
+
+    maxHp = 3,
+    size = 20,       -- collision size
+    hitRange = 1.5,  -- reduced from larger values
+    hitFlash = 0.1,  -- seconds of red tint after taking damage
+
+    shadowOffset = 65,
+    shadowRadius = 40,
+
+    -- Overhead bar: size in px, offset above the sprite center
+    healthBar = { width = 60, height = 6, offset = 92 },
+
+    -- Opaque bounding box of the idle/hit frames (measured from the
+    -- alpha channel), in pixels of a pickFrame-sized frame; used for
+    -- cursor picking instead of the full, mostly transparent frame
+    pickFrame = 256,
+    pickBounds = { 84, 75, 186, 175 },
+}
+
+Archetypes.mace = {
+    name = "mace",
+
+    sweep = {
+        range = 1.5,     -- reduced from 3 for closer combat
+        damage = 1,      -- reduced from 20
+        duration = 2.0,  -- 20 frames × 0.1s = 2s
+        minDot = 0.4,    -- cone in front of the aim direction
+    },
+
+    slam = {
+        radius = 2,      -- reduced from 4 for closer combat
+        damage = 1,      -- reduced from 40
+        duration = 2.4,  -- 24 frames × 0.1s = 2.4s
+    },
+
+    -- Damage lands 70% through the animation (last 30% for hit/death anim)
+    damageDelay = 0.7,
+
+    -- Status effect left on everything the slam hits
+    slamEffect = "burn",
+}
+
+-- Status effects (see core/effects.lua); durations in seconds.
+-- `damage` is dealt every effect tick, `stat` is multiplied by `value`
+-- on the target while the effect lasts.
+Archetypes.effects = {
+    burn = {
+        duration = 2,
+        damage = 0.125,  -- 8 ticks = 1 hp over the duration
+    },
+    slow = {
+        duration = 2,
+        stat = "speedScale",
+        value = 0.5,
+    },
+    haste = {
+        duration = 4,
+        stat = "speedScale",
+        value = 1.5,
+    },
+}
+
+return Archetypes
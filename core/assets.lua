@@ -0,0 +1,123 @@
+-- Asset loading from the packed archive.
+-- tools/pack_assets.lua writes assets.pak: a text index of
+-- "path<TAB>offset<TAB>size" lines, a blank line, then every file's bytes
+-- back to back in load order. At runtime the archive stays open on one
+-- handle and each asset is read as a FileData slice, so startup reads the
+-- file front to back. Paths missing from the archive (or no archive at
+-- all) fall back to loose files.
+-- --record-asset-order writes the order assets were requested in to
+-- asset_order.txt in the save directory, for the packer.
+local Memory = require("core.memory")
+
+local Assets = {}
+
+Assets.ARCHIVE = "assets.pak"
+local MAGIC = "LPAK1"
+
+Assets.index = nil     -- path -> { offset, size }
+Assets.requested = {}  -- paths in request order
+Assets.stats = { packed = 0, loose = 0, bytes = 0 }
+
+local file = nil
+local dataStart = 0
+local recordOrder = false
+
+function Assets.open(args)
+    for i = 1, #(args or {}) do
+        if args[i] == "--record-asset-order" then recordOrder = true end
+    end
+
+    if not love.filesystem.getInfo(Assets.ARCHIVE) then return false end
+
+    file = love.filesystem.newFile(Assets.ARCHIVE, "r")
+
+    -- Read the header a chunk at a time; the index ends at a blank line
+    local header, pos = "", nil
+    repeat
+        local chunk = file:read(65536)
+        if not chunk or #chunk == 0 then break end
+        header = header .. chunk
+        pos = header:find("\n\n", 1, true)
+    until pos
+
+    if not pos or header:sub(1, #MAGIC + 1) ~= MAGIC .. "\n" then
+        print("Assets: " .. Assets.ARCHIVE .. " is not a valid archive, using loose files")
+        file:close()
+        file = nil
+        return false
+    end
+
+    Assets.index = {}
+    local count = 0
+    for line in header:sub(#MAGIC + 2, pos):gmatch("([^\n]+)\n") do
+        local path, offset, size = line:match("^(.-)\t(%d+)\t(%d+)$")
+        if path then
+            Assets.index[path] = { tonumber(offset), tonumber(size) }
+            count = count + 1
+        end
+    end
+    dataStart = pos + 1  -- bytes before the first file
+
+    print(string.format("Assets: %d files in %s", count, Assets.ARCHIVE))
+    return true
+end
+
+function Assets.close()
+    if file then file:close() end
+    file = nil
+    Assets.index = nil
+end
+
+-- FileData for `path`, named after it so decoders can use the extension
+function Assets.fileData(path)
+    table.insert(Assets.requested, path)
+
+    local entry = Assets.index and Assets.index[path]
+    if entry then
+        file:seek(dataStart + entry[1])
+        local contents = file:read(entry[2])
+        Assets.stats.packed = Assets.stats.packed + 1
+        Assets.stats.bytes = Assets.stats.bytes + entry[2]
+        return love.filesystem.newFileData(contents, path)
+    end
+
+    Assets.stats.loose = Assets.stats.loose + 1
+    return love.filesystem.newFileData(path)
+end
+
+function Assets.image(path, settings)
+    local image = love.graphics.newImage(Assets.fileData(path), settings)
+    Memory.trackTexture(path, image)
+    return image
+end
+
+-- Static sources are decoded here so their SoundData size can be counted
+function Assets.source(path, sourceType)
+    sourceType = sourceType or "static"
+    if sourceType ~= "static" then
+        return love.audio.newSource(Assets.fileData(path), sourceType)
+    end
+
+    local soundData = love.sound.newSoundData(Assets.fileData(path))
+    local source = love.audio.newSource(soundData, sourceType)
+    Memory.trackSoundData(path, soundData, source)
+    return source
+end
+
+-- Save the request order (first use of each path) when recording
+function Assets.saveOrder()
+    if not recordOrder then return end
+
+    local seen = {}
+    local lines = { "# Recorded by `love . --record-asset-order`; read by tools/pack_assets.lua" }
+    for _, path in ipairs(Assets.requested) do
+        if not seen[path] then
+            seen[path] = true
+            table.insert(lines, path)
+        end
+    end
+    love.filesystem.write("asset_order.txt", table.concat(lines, "\n") .. "\n")
+    print(string.format("Assets: wrote %d paths to asset_order.txt", #lines - 1))
+end
+
+return Assets
@@ -1,16 +1,19 @@
+local Assets = require("core.assets")
+local Throttle = require("core.throttle")
+
 local Audio = {
     playing = {},
     delayed = {}  -- Queue for delayed sounds
 }
 function Audio.load()
     local sounds = {
-        dash    = love.audio.newSource("assets/sounds/dash.wav", "static"),
-        hit     = love.audio.newSource("assets/sounds/attack.wav", "static"),
-        attack_swipe = love.audio.newSource("assets/sounds/attack.wav", "static"),
-        attack_jump = love.audio.newSource("assets/sounds/attack.wav", "static"),
-        enemy_damage = love.audio.newSource("assets/sounds/enemy_damage.wav", "static"),
-        death   = love.audio.newSource("assets/sounds/death.wav", "static"),
-        victory = love.audio.newSource("assets/sounds/win.wav", "static")
+        dash    = Assets.source("assets/sounds/dash.wav"),
+        hit     = Assets.source("assets/sounds/attack.wav"),
+        attack_swipe = Assets.source("assets/sounds/attack.wav"),
+        attack_jump = Assets.source("assets/sounds/attack.wav"),
+        enemy_damage = Assets.source("assets/sounds/enemy_damage.wav"),
+        death   = Assets.source("assets/sounds/death.wav"),
+        victory = Assets.source("assets/sounds/win.wav")
     }
 
     sounds.dash:setVolume(0.6)
@@ -29,7 +32,10 @@ function Audio.load()
     return sounds
 end
 
+-- Nothing starts while the window is hidden (see core/throttle.lua)
 function Audio.play(src)
+    if not Throttle.visible then return end
+
     local s = src:clone()
     s:play()
     table.insert(Audio.playing, s)
@@ -54,6 +60,9 @@ function Audio.update(dt)
         end
     end
     
+    -- Paused while hidden, not finished; keep them until they resume
+    if not Throttle.visible then return end
+
     -- Clean up finished sounds
     for i = #Audio.playing, 1, -1 do
         if not Audio.playing[i]:isPlaying() then
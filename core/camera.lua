@@ -10,18 +10,31 @@ function Camera.new(x, y)
     self.targetY = y
     self.smoothness = 6
 
+    -- Screen rect this camera renders into (full window by default)
+    self:setViewport(0, 0, love.graphics.getWidth(), love.graphics.getHeight())
+
     return self
 end
 
+function Camera:setViewport(x, y, w, h)
+    self.viewX = x
+    self.viewY = y
+    self.viewW = w
+    self.viewH = h
+end
+
 function Camera:update(px, py, iso, tileH, dt)
     local sx, sy = iso(px, py)
-    local sw, sh = love.graphics.getWidth(), love.graphics.getHeight()
+    local sw, sh = self.viewW, self.viewH
 
     self.targetX = sw / 2 - sx
     self.targetY = sh / 2 - sy + tileH / 2
 
-    self.x = self.x + (self.targetX - self.x) * self.smoothness * dt
-    self.y = self.y + (self.targetY - self.y) * self.smoothness * dt
+    -- Frame-rate independent and never past the target, even for the
+    -- long dt of a throttled or stalled frame
+    local t = 1 - math.exp(-self.smoothness * dt)
+    self.x = self.x + (self.targetX - self.x) * t
+    self.y = self.y + (self.targetY - self.y) * t
 end
 
 return Camera
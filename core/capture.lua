@@ -0,0 +1,100 @@
+-- Frame capture for bug reports and clips.
+-- The render thread only queues love.graphics.captureScreenshot and hands
+-- the resulting ImageData to a channel; love.thread workers encode it
+-- (PNG sequence or raw RGBA) into the save directory and release it.
+-- At most `ring` frames are in flight: when encoders fall behind, frames
+-- are dropped and counted instead of piling up in memory.
+local Capture = {}
+Capture.__index = Capture
+
+local WORKER_FILE = "core/capture_worker.lua"
+
+function Capture.new(opts)
+    local self = setmetatable({}, Capture)
+
+    opts = opts or {}
+    self.ring = opts.ring or 8
+    self.workers = opts.workers or 2
+    self.format = opts.format or "png"  -- "png" or "raw"
+
+    self.recording = false
+    self.frame = 0     -- frames requested
+    self.captured = 0  -- frames delivered to the encoders
+    self.dropped = 0
+    self.dir = nil
+
+    self.jobs = nil  -- per recording, see start()
+    self.free = nil
+    self.threads = {}
+
+    -- Created once so capturing doesn't allocate a closure per frame
+    self.onCapture = function(imageData)
+        self.captured = self.captured + 1
+        self.jobs:push({ self.captured, imageData })
+    end
+
+    return self
+end
+
+function Capture:start()
+    if self.recording then return end
+
+    self.dir = "captures/" .. os.date("%Y%m%d_%H%M%S")
+    love.filesystem.createDirectory(self.dir)
+
+    self.frame = 0
+    self.captured = 0
+    self.dropped = 0
+
+    -- Fresh channels each time: workers of an earlier recording may still
+    -- be draining, and must neither return their tokens into this ring
+    -- nor take this recording's frames or quit messages
+    self.jobs = love.thread.newChannel()
+    self.free = love.thread.newChannel()
+    for _ = 1, self.ring do self.free:push(true) end
+
+    for i = 1, self.workers do
+        local thread = love.thread.newThread(WORKER_FILE)
+        thread:start(self.jobs, self.free, self.dir, self.format)
+        self.threads[i] = thread
+    end
+
+    self.recording = true
+    print("Capture: recording to " .. love.filesystem.getSaveDirectory() .. "/" .. self.dir)
+end
+
+function Capture:stop()
+    if not self.recording then return end
+
+    -- Workers drain the frames already queued before they see "quit";
+    -- they finish in the background on this recording's channels
+    for _ = 1, #self.threads do self.jobs:push("quit") end
+    self.threads = {}
+    self.recording = false
+
+    print(string.format("Capture: %d frames, %d dropped", self.frame, self.dropped))
+end
+
+function Capture:toggle()
+    if self.recording then self:stop() else self:start() end
+end
+
+-- Call at the end of love.draw; the screenshot is taken after present
+function Capture:captureFrame()
+    if not self.recording then return end
+
+    if not self.free:pop() then
+        self.dropped = self.dropped + 1
+        return
+    end
+
+    self.frame = self.frame + 1
+    love.graphics.captureScreenshot(self.onCapture)
+end
+
+function Capture:inFlight()
+    if not self.free then return 0 end
+    return self.ring - self.free:getCount()
+end
+
+return Capture
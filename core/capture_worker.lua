@@ -0,0 +1,25 @@
+-- Thread body for Capture: encodes captured frames and frees them.
+require("love.filesystem")
+require("love.image")
+require("love.data")
+
+local jobs, free, dir, format = ...
+
+while true do
+    local job = jobs:demand()
+    if job == "quit" then break end
+
+    local frame, imageData = job[1], job[2]
+
+    if format == "raw" then
+        local name = string.format("%s/frame_%06d_%dx%d.rgba", dir, frame,
+            imageData:getWidth(), imageData:getHeight())
+        love.filesystem.write(name, imageData)
+    else
+        imageData:encode("png", string.format("%s/frame_%06d.png", dir, frame))
+    end
+
+    -- Free the pixels now rather than whenever this thread's GC runs
+    imageData:release()
+    free:push(true)
+end
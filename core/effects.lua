@@ -0,0 +1,174 @@
+-- Status effects (damage over time, slows, buffs).
+-- Active effects live in flat parallel arrays, one slot per
+-- (entity, effect) pair, and are ticked together in one pass at a fixed
+-- rate instead of each entity running its own timers every frame.
+-- Definitions come from Archetypes.effects.
+local Archetypes = require("core.archetypes")
+
+local Effects = {}
+Effects.__index = Effects
+
+Effects.TICK = 0.25          -- seconds per effect tick
+local MAX_TICKS_PER_UPDATE = 4
+
+-- Stable numeric ids for effect kinds
+local KIND_NAMES = {}
+local KIND_IDS = {}
+for name in pairs(Archetypes.effects) do
+    table.insert(KIND_NAMES, name)
+end
+table.sort(KIND_NAMES)
+for id, name in ipairs(KIND_NAMES) do
+    KIND_IDS[name] = id
+end
+
+function Effects.new()
+    local self = setmetatable({}, Effects)
+
+    -- Parallel arrays, 1..count
+    self.entity = {}
+    self.kind = {}
+    self.ticks = {}   -- effect ticks left
+    self.value = {}   -- damage per tick, or stat multiplier
+    self.count = 0
+
+    -- Per kind: entity -> slot, so reapplying refreshes instead of stacking
+    self.index = {}
+    for id = 1, #KIND_NAMES do
+        self.index[id] = setmetatable({}, { __mode = "k" })
+    end
+
+    self.accum = 0
+
+    self.stats = {
+        active = 0,
+        ticks = 0,
+        lastTickMs = 0,
+    }
+
+    return self
+end
+
+local function ticksFor(duration)
+    return math.max(1, math.ceil(duration / Effects.TICK - 1e-9))
+end
+
+function Effects:apply(entity, name)
+    local id = KIND_IDS[name]
+    local def = Archetypes.effects[name]
+    local ticks = ticksFor(def.duration)
+
+    local slot = self.index[id][entity]
+    if slot then
+        if ticks > self.ticks[slot] then self.ticks[slot] = ticks end
+        return
+    end
+
+    local n = self.count + 1
+    self.count = n
+    self.entity[n] = entity
+    self.kind[n] = id
+    self.ticks[n] = ticks
+    self.value[n] = def.damage or def.value
+    self.index[id][entity] = n
+
+    if def.stat then
+        entity[def.stat] = (entity[def.stat] or 1) * def.value
+    end
+end
+
+-- Apply `name` to every live entity within `radius` of (x, y); returns
+-- how many were affected
+function Effects:applyArea(name, x, y, radius, entities)
+    local r2 = radius * radius
+    local n = 0
+    for i = 1, #entities do
+        local e = entities[i]
+        if not e.dead then
+            local dx, dy = e.x - x, e.y - y
+            if dx * dx + dy * dy <= r2 then
+                self:apply(e, name)
+                n = n + 1
+            end
+        end
+    end
+    return n
+end
+
+-- Swap-remove slot i, undoing any stat change
+function Effects:remove(i)
+    local entity, id = self.entity[i], self.kind[i]
+    local def = Archetypes.effects[KIND_NAMES[id]]
+
+    if def.stat then
+        local v = (entity[def.stat] or 1) / def.value
+        entity[def.stat] = math.abs(v - 1) > 1e-6 and v or nil
+    end
+    self.index[id][entity] = nil
+
+    local last = self.count
+    if i ~= last then
+        local moved, movedKind = self.entity[last], self.kind[last]
+        self.entity[i] = moved
+        self.kind[i] = movedKind
+        self.ticks[i] = self.ticks[last]
+        self.value[i] = self.value[last]
+        self.index[movedKind][moved] = i
+    end
+    self.entity[last] = nil
+    self.count = last - 1
+end
+
+-- One batched pass over every active effect; returns hits, kills
+function Effects:tick()
+    local entity, kind, ticks, value = self.entity, self.kind, self.ticks, self.value
+    local hits, kills = 0, 0
+
+    local i = 1
+    while i <= self.count do
+        local e = entity[i]
+        local alive = not e.dead
+
+        if alive and Archetypes.effects[KIND_NAMES[kind[i]]].damage then
+            -- quiet: no hit-reaction animation restart every tick
+            e:takeDamage(value[i], true)
+            hits = hits + 1
+            if e.dead then kills = kills + 1 end
+            alive = not e.dead
+        end
+
+        ticks[i] = ticks[i] - 1
+        if not alive or ticks[i] <= 0 then
+            self:remove(i)  -- slot i now holds the old last slot
+        else
+            i = i + 1
+        end
+    end
+
+    return hits, kills
+end
+
+-- Advance the fixed-rate clock; returns hits, kills from any ticks run
+function Effects:update(dt)
+    self.accum = self.accum + dt
+
+    local hits, kills, steps = 0, 0, 0
+    if self.accum >= Effects.TICK then
+        local start = love.timer.getTime()
+        while self.accum >= Effects.TICK and steps < MAX_TICKS_PER_UPDATE do
+            self.accum = self.accum - Effects.TICK
+            local h, k = self:tick()
+            hits, kills, steps = hits + h, kills + k, steps + 1
+        end
+        -- Don't carry a backlog out of a long stall
+        if self.accum >= Effects.TICK then self.accum = 0 end
+
+        self.stats.ticks = self.stats.ticks + steps
+        self.stats.lastTickMs = (love.timer.getTime() - start) * 1000 / steps
+    end
+
+    self.stats.active = self.count
+    return hits, kills
+end
+
+return Effects
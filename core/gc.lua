@@ -0,0 +1,90 @@
+-- Frame-budgeted garbage collection.
+-- In the "frame" profile the automatic collector is pushed back (high
+-- pause) and incremental steps run in the slack left at the end of each
+-- frame instead, so collection work lands between frames rather than in
+-- the middle of a draw. The automatic collector stays armed as a backstop
+-- if slack runs out. Full collections happen only at breakpoints.
+local GC = {}
+
+GC.profiles = {
+    default    = { pause = 200, stepmul = 200, slack = false },  -- Lua defaults
+    frame      = { pause = 300, stepmul = 200, slack = true },
+    throughput = { pause = 400, stepmul = 400, slack = false },  -- loading
+}
+
+GC.config = {
+    targetStepCost = 0.0002,  -- seconds per collectgarbage("step") call
+    margin = 0.0005,          -- slack kept back for scheduling noise
+    growth = 0.25,            -- heap growth since last cycle before stepping
+}
+
+GC.profile = nil
+GC.stepSize = 16       -- collectgarbage("step") argument, retuned live
+GC.stepCost = 0        -- smoothed seconds per step
+GC.cycleKB = 0         -- heap size when the last cycle finished
+GC.collecting = false  -- a slack-driven cycle is in progress
+-- steps: this frame's; stepsTotal: since startup
+GC.stats = { steps = 0, stepsTotal = 0, cycles = 0, breakpoints = 0, lastBreakpoint = nil }
+
+function GC.setProfile(name)
+    local p = assert(GC.profiles[name], "unknown GC profile: " .. tostring(name))
+    GC.profile = p
+    GC.profileName = name
+    collectgarbage("setpause", p.pause)
+    collectgarbage("setstepmul", p.stepmul)
+end
+
+-- Run incremental steps until `slack` seconds are used up
+function GC.useSlack(slack)
+    local steps = 0
+
+    -- Don't start a new cycle until the heap has grown a bit
+    if not GC.collecting and collectgarbage("count") > GC.cycleKB * (1 + GC.config.growth) then
+        GC.collecting = true
+    end
+
+    if GC.collecting and GC.profile and GC.profile.slack then
+        local getTime = love.timer.getTime
+        local now = getTime()
+        local stop = now + slack - GC.config.margin
+
+        while now + GC.stepCost < stop do
+            local finished = collectgarbage("step", GC.stepSize)
+            local t = getTime()
+            local cost = t - now
+            now = t
+            steps = steps + 1
+
+            GC.stepCost = GC.stepCost * 0.9 + cost * 0.1
+
+            -- Keep each step near the target cost so we can stop on time
+            local target = GC.config.targetStepCost
+            if cost < target * 0.5 and GC.stepSize < 1024 then
+                GC.stepSize = GC.stepSize * 2
+            elseif cost > target * 2 and GC.stepSize > 1 then
+                GC.stepSize = GC.stepSize / 2
+            end
+
+            if finished then
+                GC.stats.cycles = GC.stats.cycles + 1
+                GC.cycleKB = collectgarbage("count")
+                GC.collecting = false
+                break
+            end
+        end
+    end
+    GC.stats.steps = steps
+    GC.stats.stepsTotal = GC.stats.stepsTotal + steps
+    return steps
+end
+
+-- Full collection at a natural pause (wave transition, victory screen)
+function GC.breakpoint(reason)
+    collectgarbage("collect")
+    GC.cycleKB = collectgarbage("count")
+    GC.collecting = false
+    GC.stats.breakpoints = GC.stats.breakpoints + 1
+    GC.stats.lastBreakpoint = reason
+end
+
+return GC
@@ -0,0 +1,163 @@
+-- Hitch detector.
+-- Always on: every frame records its scoped timings, GC activity and game
+-- counters into a fixed ring of FFI arrays (no allocation per frame),
+-- along with recent input. When a frame takes longer than `factor` times
+-- the target frame time, the ring is written to hitches/ in the save
+-- directory, so a rare hitch in a long session leaves a trace without
+-- anyone having to reproduce it. F10 dumps on demand.
+local ffi = require("ffi")
+local GC = require("core.gc")
+
+local Hitch = {}
+
+Hitch.config = {
+    frames = 120,      -- frames kept in the ring
+    factor = 2,        -- hitch = frame over factor x target
+    cooldown = 5,      -- seconds between automatic dumps
+    armAfter = 120,    -- frames to skip after startup
+    maxScopes = 16,
+    maxCounters = 8,
+    inputs = 32,       -- recent input events kept
+}
+
+Hitch.target = 1 / 60  -- seconds; set by the loop from cap/refresh rate
+Hitch.dumps = 0
+
+local config = Hitch.config
+local FRAMES, MAX_SCOPES, MAX_COUNTERS = config.frames, config.maxScopes, config.maxCounters
+
+local scopeNames, counterNames = {}, {}
+local scopeTimes = ffi.new("double[?]", FRAMES * MAX_SCOPES)
+local scopeStart = ffi.new("double[?]", MAX_SCOPES)
+local counters = ffi.new("double[?]", FRAMES * MAX_COUNTERS)
+local frameMs = ffi.new("double[?]", FRAMES)
+local heapKB = ffi.new("double[?]", FRAMES)
+local gcSteps = ffi.new("int32_t[?]", FRAMES)
+local frameNo = ffi.new("int32_t[?]", FRAMES)
+local current = ffi.new("double[?]", MAX_COUNTERS)  -- latest counter values
+
+-- Input ring; kinds and values are interned strings/numbers, not copies
+local inputKind, inputValue = {}, {}
+local inputTime = ffi.new("double[?]", config.inputs)
+local inputIndex, inputCount = 0, 0
+
+local slot = 0
+local filled = 0
+local frames = 0
+local lastDump = -math.huge
+
+local getTime = love.timer.getTime
+
+function Hitch.scope(name)
+    assert(#scopeNames < MAX_SCOPES, "too many hitch scopes")
+    scopeNames[#scopeNames + 1] = name
+    return #scopeNames
+end
+
+function Hitch.counter(name)
+    assert(#counterNames < MAX_COUNTERS, "too many hitch counters")
+    counterNames[#counterNames + 1] = name
+    return #counterNames
+end
+
+function Hitch.begin(id)
+    scopeStart[id - 1] = getTime()
+end
+
+function Hitch.finish(id)
+    local i = slot * MAX_SCOPES + id - 1
+    scopeTimes[i] = scopeTimes[i] + (getTime() - scopeStart[id - 1])
+end
+
+function Hitch.set(id, value)
+    current[id - 1] = value
+end
+
+function Hitch.input(kind, value)
+    inputIndex = inputIndex % config.inputs + 1
+    inputKind[inputIndex] = kind
+    inputValue[inputIndex] = value
+    inputTime[inputIndex - 1] = getTime()
+    if inputCount < config.inputs then inputCount = inputCount + 1 end
+end
+
+function Hitch.dump(reason)
+    local lines = {}
+    local function add(fmt, ...) lines[#lines + 1] = string.format(fmt, ...) end
+
+    add("hitch: %s", reason)
+    add("time %.3f s  target %.2f ms  threshold %.2f ms", getTime(),
+        Hitch.target * 1000, Hitch.target * config.factor * 1000)
+    add("gc: profile %s  step size %d  %.3f ms/step  cycles %d  breakpoints %d (last %s)",
+        GC.profileName or "-", GC.stepSize, GC.stepCost * 1000, GC.stats.cycles,
+        GC.stats.breakpoints, tostring(GC.stats.lastBreakpoint))
+    add("")
+
+    -- Header row: frame, ms, heap, gc steps, scopes..., counters...
+    local header = { "frame", "ms", "heapKB", "gcSteps" }
+    for _, name in ipairs(scopeNames) do header[#header + 1] = name .. "Ms" end
+    for _, name in ipairs(counterNames) do header[#header + 1] = name end
+    add("%s", table.concat(header, "\t"))
+
+    for k = filled - 1, 0, -1 do
+        local s = (slot - k) % FRAMES
+        local row = {
+            string.format("%d", frameNo[s]),
+            string.format("%.2f", frameMs[s]),
+            string.format("%.0f", heapKB[s]),
+            string.format("%d", gcSteps[s]),
+        }
+        for i = 1, #scopeNames do
+            row[#row + 1] = string.format("%.3f", scopeTimes[s * MAX_SCOPES + i - 1] * 1000)
+        end
+        for i = 1, #counterNames do
+            row[#row + 1] = string.format("%g", counters[s * MAX_COUNTERS + i - 1])
+        end
+        add("%s", table.concat(row, "\t"))
+    end
+
+    add("")
+    add("recent input (newest last):")
+    for k = inputCount - 1, 0, -1 do
+        local i = (inputIndex - 1 - k) % config.inputs + 1
+        add("  %.3f  %s %s", inputTime[i - 1], tostring(inputKind[i]), tostring(inputValue[i]))
+    end
+
+    Hitch.dumps = Hitch.dumps + 1
+    local name = string.format("hitches/hitch_%s_%d.txt", os.date("%Y%m%d_%H%M%S"), Hitch.dumps)
+    love.filesystem.createDirectory("hitches")
+    love.filesystem.write(name, table.concat(lines, "\n") .. "\n")
+    print(string.format("Hitch: %s -> %s/%s", reason, love.filesystem.getSaveDirectory(), name))
+end
+
+-- Close the frame that just ended (its interval is `interval` seconds)
+-- and start recording the next. Throttled frames are recorded but never
+-- count as hitches.
+function Hitch.endFrame(interval, throttled)
+    frames = frames + 1
+
+    frameMs[slot] = interval * 1000
+    heapKB[slot] = collectgarbage("count")
+    gcSteps[slot] = GC.stats.steps
+    frameNo[slot] = frames
+    for i = 0, #counterNames - 1 do
+        counters[slot * MAX_COUNTERS + i] = current[i]
+    end
+    if filled < FRAMES then filled = filled + 1 end
+
+    if not throttled and frames > config.armAfter
+        and interval > Hitch.target * config.factor then
+        local now = getTime()
+        if now - lastDump >= config.cooldown then
+            lastDump = now
+            Hitch.dump(string.format("frame %d took %.2f ms", frames, interval * 1000))
+        end
+    end
+
+    slot = (slot + 1) % FRAMES
+    for i = 0, MAX_SCOPES - 1 do
+        scopeTimes[slot * MAX_SCOPES + i] = 0
+    end
+end
+
+return Hitch
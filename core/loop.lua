@@ -0,0 +1,219 @@
+-- Replacement for LÖVE's default love.run.
+-- Frames are paced to a configurable cap with a hybrid wait: sleep for
+-- most of the slack, then spin for the last couple of milliseconds, since
+-- OS sleeps overshoot by about 1 ms. Input is pumped after that wait,
+-- right before love.update, so the simulation sees the freshest input.
+-- Command line: --fps-cap <n>, --low-latency (vsync off, capped to refresh)
+--
+-- Besides love.update(dt), once per frame, the loop calls love.tick(dt)
+-- for the game's timing-sensitive clocks. A long frame (throttled, or a
+-- hitch) is fed to love.tick in substeps of at most
+-- Throttle.config.maxStep, while love.update still runs once. After
+-- every frame, drawn or not (hidden windows skip drawing), the loop
+-- calls love.endframe(drawn).
+local Throttle = require("core.throttle")
+local GC = require("core.gc")
+local Hitch = require("core.hitch")
+
+local Loop = {}
+
+Loop.config = {
+    fpsCap = 0,          -- 0 = uncapped (vsync paces the frame)
+    lowLatency = false,  -- vsync off, cap to the display refresh rate
+    spinMargin = 0.002,  -- seconds of busy-wait before the deadline
+    gcProfile = "frame", -- see core/gc.lua
+}
+
+local HISTORY = 240
+
+local frameTimes = {}
+local frameIndex = 0
+local frameCount = 0
+
+local stats = { mean = 0, stddev = 0, worst = 0 }
+
+-- Hitch detector scopes for the loop's own phases
+local SCOPE_EVENTS  = Hitch.scope("events")
+local SCOPE_UPDATE  = Hitch.scope("update")
+local SCOPE_DRAW    = Hitch.scope("draw")
+local SCOPE_PRESENT = Hitch.scope("present")
+local SCOPE_GC      = Hitch.scope("gc")
+
+function Loop.configure(args)
+    local config = Loop.config
+    for i = 1, #args do
+        if args[i] == "--fps-cap" then
+            config.fpsCap = tonumber(args[i + 1]) or config.fpsCap
+        elseif args[i] == "--low-latency" then
+            config.lowLatency = true
+        end
+    end
+end
+
+local function recordFrame(ft)
+    frameIndex = frameIndex % HISTORY + 1
+    frameTimes[frameIndex] = ft
+    if frameCount < HISTORY then frameCount = frameCount + 1 end
+end
+
+-- Mean, standard deviation and worst of the last HISTORY frame intervals
+function Loop.getStats()
+    if frameCount == 0 then return stats end
+
+    local sum, worst = 0, 0
+    for i = 1, frameCount do
+        local ft = frameTimes[i]
+        sum = sum + ft
+        if ft > worst then worst = ft end
+    end
+    local mean = sum / frameCount
+
+    local var = 0
+    for i = 1, frameCount do
+        local d = frameTimes[i] - mean
+        var = var + d * d
+    end
+
+    stats.mean = mean
+    stats.stddev = math.sqrt(var / frameCount)
+    stats.worst = worst
+    return stats
+end
+
+-- Raw interval ring (seconds) and how many entries are filled; read-only
+function Loop.getFrameTimes()
+    return frameTimes, frameCount
+end
+
+function Loop.waitUntil(deadline)
+    local getTime = love.timer.getTime
+    local remaining = deadline - getTime()
+
+    if remaining > Loop.config.spinMargin then
+        love.timer.sleep(remaining - Loop.config.spinMargin)
+    end
+    while getTime() < deadline do end
+end
+
+local function pumpEvents()
+    love.event.pump()
+    for name, a, b, c, d, e, f in love.event.poll() do
+        if name == "quit" then
+            if not love.quit or not love.quit() then
+                return a or 0
+            end
+        end
+        love.handlers[name](a, b, c, d, e, f)
+    end
+end
+
+function Loop.run()
+    local args = love.arg.parseGameArguments(arg)
+    Loop.configure(args)
+
+    local config = Loop.config
+    if config.lowLatency then
+        love.window.setVSync(0)
+        if config.fpsCap == 0 then
+            local _, _, flags = love.window.getMode()
+            config.fpsCap = (flags.refreshrate and flags.refreshrate > 0) and flags.refreshrate or 60
+        end
+    end
+
+    -- Loading allocates a lot; switch to per-frame stepping afterwards
+    GC.setProfile("throughput")
+    if love.load then love.load(args, arg) end
+    GC.setProfile(config.gcProfile)
+
+    -- Frame budget when vsync paces us instead of a cap
+    local _, _, mode = love.window.getMode()
+    local refreshBudget = 1 / ((mode.refreshrate and mode.refreshrate > 0) and mode.refreshrate or 60)
+    local workTime = 0
+
+    Hitch.target = config.fpsCap > 0 and 1 / config.fpsCap or refreshBudget
+
+    love.timer.step()
+
+    local getTime = love.timer.getTime
+    local deadline = getTime()
+    local lastStart = deadline
+
+    return function()
+        local throttled = Throttle.isActive()
+        local cap = Throttle.rate() or config.fpsCap
+
+        if cap > 0 then
+            deadline = deadline + 1 / cap
+            local now = getTime()
+            -- Fell behind: start a new schedule rather than bursting frames
+            if deadline < now then deadline = now end
+            Loop.waitUntil(deadline)
+        end
+
+        local start = getTime()
+        -- Throttled frames would swamp the pacing statistics
+        if not throttled then recordFrame(start - lastStart) end
+        Hitch.endFrame(start - lastStart, throttled)
+        lastStart = start
+
+        -- Late input sampling: events are read after the pacing wait
+        Hitch.begin(SCOPE_EVENTS)
+        local quit = pumpEvents()
+        Hitch.finish(SCOPE_EVENTS)
+        if quit then return quit end
+
+        local dt = love.timer.step()
+        Hitch.begin(SCOPE_UPDATE)
+        if love.tick then
+            -- Clocks see the step sizes they would at full rate; the rest
+            -- of the update runs once, so a throttled frame stays cheap
+            local maxStep = Throttle.config.maxStep
+            if dt > maxStep then
+                local steps = math.ceil(dt / maxStep)
+                for _ = 1, steps do love.tick(dt / steps) end
+            else
+                love.tick(dt)
+            end
+        end
+        if love.update then love.update(dt) end
+        Hitch.finish(SCOPE_UPDATE)
+
+        local drawn = love.graphics.isActive() and Throttle.shouldDraw()
+        if drawn then
+            Hitch.begin(SCOPE_DRAW)
+            love.graphics.origin()
+            love.graphics.clear(love.graphics.getBackgroundColor())
+            if love.draw then love.draw() end
+            Hitch.finish(SCOPE_DRAW)
+        end
+
+        -- Work ends before present: with vsync, present blocks until the
+        -- vblank, and counting that wait would leave no slack at all
+        local workEnd = getTime()
+
+        if drawn then
+            Hitch.begin(SCOPE_PRESENT)
+            love.graphics.present()
+            Hitch.finish(SCOPE_PRESENT)
+        end
+
+        if love.endframe then love.endframe(drawn) end
+
+        -- GC in the slack: up to the next deadline when capped, otherwise
+        -- the refresh budget minus the work this frame measured
+        local now = getTime()
+        Hitch.begin(SCOPE_GC)
+        if cap > 0 then
+            GC.useSlack(deadline + 1 / cap - now - config.spinMargin)
+        else
+            workTime = workTime * 0.9 + (workEnd - start) * 0.1
+            GC.useSlack(refreshBudget - workTime)
+        end
+        Hitch.finish(SCOPE_GC)
+
+        -- Uncapped without vsync still yields a little to the OS
+        if cap == 0 then love.timer.sleep(0.001) end
+    end
+end
+
+return Loop
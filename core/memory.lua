@@ -0,0 +1,178 @@
+-- Memory accounting per asset category.
+-- Loaders report what they create: textures are sized from dimensions,
+-- pixel format, mipmaps and layers (the decoded/VRAM size, not the file
+-- size), audio from the decoded SoundData, meshes from their vertex
+-- count and format. The Lua heap is sampled.
+-- Residents are keyed by object, not name, so an asset loaded twice is
+-- counted twice (and dump() shows it as a duplicate). Keys are weak and
+-- update() re-sums the totals, so collected objects drop out on their own.
+-- Each category has a budget; crossing it prints a warning once, until
+-- usage drops back under. Memory.dump() lists the largest residents.
+-- --mem-budget <category>=<MB> overrides a budget.
+local Memory = {}
+
+local MB = 1024 * 1024
+
+Memory.budgets = {
+    textures = 1024 * MB,
+    canvases = 256 * MB,
+    audio = 128 * MB,
+    meshes = 64 * MB,
+    lua = 256 * MB,
+}
+
+-- Bytes per pixel; block-compressed formats are per-pixel averages
+local FORMAT_BYTES = {
+    r8 = 1, rg8 = 2, rgba8 = 4, srgba8 = 4,
+    r16 = 2, rg16 = 4, rgba16 = 8,
+    r16f = 2, rg16f = 4, rgba16f = 8,
+    r32f = 4, rg32f = 8, rgba32f = 16,
+    la8 = 2, rgba4 = 2, rgb5a1 = 2, rgb565 = 2, rgb10a2 = 4, rg11b10f = 4,
+    DXT1 = 0.5, DXT3 = 1, DXT5 = 1, BC4 = 0.5, BC5 = 1, BC6h = 1, BC7 = 1,
+    ETC1 = 0.5, ETC2rgb = 0.5, ETC2rgba = 1, ASTC4x4 = 1,
+    depth16 = 2, depth24 = 4, depth32f = 4, depth24stencil8 = 4,
+}
+
+local residents = setmetatable({}, { __mode = "k" })  -- object -> { name, category, bytes }
+Memory.totals = { textures = 0, canvases = 0, audio = 0, meshes = 0, lua = 0 }
+local warned = {}
+
+function Memory.configure(args)
+    for i = 1, #(args or {}) do
+        if args[i] == "--mem-budget" and args[i + 1] then
+            local category, mb = args[i + 1]:match("^(%w+)=(%d+)$")
+            if category then Memory.budgets[category] = tonumber(mb) * MB end
+        end
+    end
+end
+
+local function checkBudget(category)
+    local budget = Memory.budgets[category]
+    if not budget then return end
+
+    local total = Memory.totals[category] or 0
+    if total > budget and not warned[category] then
+        warned[category] = true
+        print(string.format("Memory: %s at %.1f MB is over its %.1f MB budget",
+            category, total / MB, budget / MB))
+    elseif total <= budget then
+        warned[category] = nil
+    end
+end
+
+-- `object` identifies the resident; `name` is only for dump()
+function Memory.track(category, object, name, bytes)
+    Memory.untrack(object)
+    residents[object] = { name = name, category = category, bytes = bytes }
+    Memory.totals[category] = (Memory.totals[category] or 0) + bytes
+    checkBudget(category)
+end
+
+-- Call when releasing an object early; collected ones drop out anyway
+function Memory.untrack(object)
+    local r = object and residents[object]
+    if not r then return end
+    residents[object] = nil
+    Memory.totals[r.category] = Memory.totals[r.category] - r.bytes
+end
+
+-- Decoded size of a Texture (Image or Canvas)
+function Memory.textureBytes(texture)
+    local w, h = texture:getPixelDimensions()
+    local bpp = FORMAT_BYTES[texture:getFormat()] or 4
+    local layers = texture:getLayerCount() * texture:getDepth()
+
+    local bytes = 0
+    for _ = 1, texture:getMipmapCount() do
+        bytes = bytes + math.ceil(w * h * bpp)
+        w, h = math.max(1, math.floor(w / 2)), math.max(1, math.floor(h / 2))
+    end
+    return bytes * layers
+end
+
+function Memory.trackTexture(name, texture, category)
+    Memory.track(category or "textures", texture, name, Memory.textureBytes(texture))
+end
+
+-- Keyed by `owner` (the Source playing it) when given: callers rarely
+-- keep the SoundData itself, which would then drop out as collected
+function Memory.trackSoundData(name, soundData, owner)
+    Memory.track("audio", owner or soundData, name, soundData:getSize())
+end
+
+local DATATYPE_BYTES = {
+    float = 4, byte = 1, unorm16 = 2,
+    floatvec2 = 8, floatvec3 = 12, floatvec4 = 16,  -- 12.0 names
+    unorm8vec4 = 4, unorm16vec2 = 4, unorm16vec4 = 8,
+}
+
+-- Vertex buffer size of a Mesh (plus its vertex map, if any)
+function Memory.meshBytes(mesh)
+    local stride = 0
+    for _, attr in ipairs(mesh:getVertexFormat()) do
+        local size = DATATYPE_BYTES[attr[2]] or 4
+        stride = stride + size * (attr[3] or 1)
+    end
+    local map = mesh:getVertexMap()
+    return mesh:getVertexCount() * stride + (map and #map * 4 or 0)
+end
+
+function Memory.trackMesh(name, mesh)
+    Memory.track("meshes", mesh, name, Memory.meshBytes(mesh))
+end
+
+-- Re-sum the categories (collected residents drop out) and sample the
+-- Lua heap; a few hundred residents, cheap enough once a frame
+function Memory.update()
+    local totals = Memory.totals
+    for category in pairs(totals) do totals[category] = 0 end
+    for _, r in pairs(residents) do
+        totals[r.category] = totals[r.category] + r.bytes
+    end
+    totals.lua = collectgarbage("count") * 1024
+
+    for category in pairs(Memory.budgets) do checkBudget(category) end
+end
+
+-- Print category totals against budgets, then the `count` largest residents
+function Memory.dump(count)
+    count = count or 20
+    Memory.update()
+
+    print("== memory ==")
+    local categories = {}
+    for category in pairs(Memory.totals) do table.insert(categories, category) end
+    table.sort(categories)
+    for _, category in ipairs(categories) do
+        local budget = Memory.budgets[category]
+        print(string.format("  %-9s %9.1f MB / %s", category, Memory.totals[category] / MB,
+            budget and string.format("%.0f MB", budget / MB) or "-"))
+    end
+
+    -- Same name and category listed once, with the copies summed
+    local list, byName, copies = {}, {}, 0
+    for _, r in pairs(residents) do
+        local key = r.category .. "\0" .. r.name
+        local entry = byName[key]
+        if entry then
+            entry.bytes = entry.bytes + r.bytes
+            entry.count = entry.count + 1
+            copies = copies + 1
+        else
+            entry = { name = r.name, category = r.category, bytes = r.bytes, count = 1 }
+            byName[key] = entry
+            table.insert(list, entry)
+        end
+    end
+    table.sort(list, function(a, b) return a.bytes > b.bytes end)
+
+    print(string.format("largest %d of %d residents (%d duplicate loads):",
+        math.min(count, #list), #list, copies))
+    for i = 1, math.min(count, #list) do
+        local r = list[i]
+        print(string.format("  %8.2f MB  %-9s %s%s", r.bytes / MB, r.category, r.name,
+            r.count > 1 and string.format("  (x%d)", r.count) or ""))
+    end
+end
+
+return Memory
@@ -0,0 +1,211 @@
+-- Runtime metrics export for playtest fleets.
+-- Metrics are registered once at startup, each with a reader function;
+-- values live in a preallocated array. Every `interval` seconds the
+-- registry is sampled at the end of a frame (after drawing, so graphics
+-- stats cover the whole frame; also on frames that draw nothing while
+-- the window is hidden) and exported as a Prometheus textfile
+-- and/or StatsD gauges over UDP. Nothing is sampled or allocated in
+-- between exports.
+-- Command line:
+--   --metrics-file <path>     Prometheus textfile (node_exporter collector)
+--   --statsd <host[:port]>    StatsD over UDP, port defaults to 8125
+--   --metrics-interval <s>    seconds between exports (default 10)
+-- tools/metrics_receiver.lua is a stand-in receiver for checking output.
+local Loop = require("core.loop")
+local GC = require("core.gc")
+
+local Metrics = {}
+
+Metrics.config = {
+    interval = 10,
+    file = nil,
+    statsdHost = nil,
+    statsdPort = 8125,
+    prefix = "arena",
+}
+
+Metrics.enabled = false
+
+-- Registry: parallel arrays indexed by metric id
+local names = {}      -- Prometheus name
+local labels = {}     -- Prometheus label set, "" for none
+local statsd = {}     -- StatsD name
+local helps = {}
+local kinds = {}      -- Prometheus type: "gauge" | "counter"
+local readers = {}
+local values = {}
+local count = 0
+
+local graphicsStats = {}  -- reused by love.graphics.getStats
+local sortedFrames = {}   -- scratch for quantiles
+local frameSampled = false
+
+local timer = 0
+local due = false
+local udp = nil
+
+Metrics.exports = 0
+
+function Metrics.configure(args)
+    local config = Metrics.config
+    for i = 1, #(args or {}) do
+        if args[i] == "--metrics-file" and args[i + 1] then
+            config.file = args[i + 1]
+        elseif args[i] == "--statsd" and args[i + 1] then
+            local host, port = args[i + 1]:match("^([^:]+):?(%d*)$")
+            config.statsdHost = host
+            config.statsdPort = tonumber(port) or config.statsdPort
+        elseif args[i] == "--metrics-interval" then
+            config.interval = tonumber(args[i + 1]) or config.interval
+        end
+    end
+
+    Metrics.enabled = config.file ~= nil or config.statsdHost ~= nil
+    if config.statsdHost then
+        local socket = require("socket")
+        udp = socket.udp()
+        udp:setpeername(config.statsdHost, config.statsdPort)
+    end
+end
+
+-- Register a metric; `read()` returns its current value at export time
+function Metrics.define(kind, name, help, read, labelSet, statsdName)
+    count = count + 1
+    kinds[count] = kind
+    names[count] = name
+    helps[count] = help
+    readers[count] = read
+    labels[count] = labelSet or ""
+    statsd[count] = statsdName or name:gsub("^" .. Metrics.config.prefix .. "_", "")
+    values[count] = 0
+    return count
+end
+
+local function frameQuantile(q)
+    return function()
+        if not frameSampled then
+            local times, n = Loop.getFrameTimes()
+            for i = 1, n do sortedFrames[i] = times[i] end
+            for i = #sortedFrames, n + 1, -1 do sortedFrames[i] = nil end
+            table.sort(sortedFrames)
+            frameSampled = true
+        end
+        local n = #sortedFrames
+        if n == 0 then return 0 end
+        return sortedFrames[math.max(1, math.ceil(q * n))]
+    end
+end
+
+-- The built-in set; `game` holds the live `enemies` list and `effects`
+function Metrics.defineDefaults(game)
+    local p = Metrics.config.prefix
+
+    -- Quantiles as a labelled gauge: there's no running sum/count to
+    -- make a proper summary from
+    Metrics.define("gauge", p .. "_frame_seconds", "Frame interval quantiles over the last 240 frames",
+        frameQuantile(0.5), 'quantile="0.5"', "frame_seconds.p50")
+    Metrics.define("gauge", p .. "_frame_seconds", nil,
+        frameQuantile(0.9), 'quantile="0.9"', "frame_seconds.p90")
+    Metrics.define("gauge", p .. "_frame_seconds", nil,
+        frameQuantile(0.99), 'quantile="0.99"', "frame_seconds.p99")
+
+    Metrics.define("gauge", p .. "_enemies", "Live enemies",
+        function() return #game.enemies end)
+    Metrics.define("gauge", p .. "_effects_active", "Active status effects",
+        function() return game.effects.count end)
+    Metrics.define("gauge", p .. "_draw_calls", "Draw calls in the sampled frame",
+        function() return graphicsStats.drawcalls or 0 end)
+    Metrics.define("gauge", p .. "_texture_memory_bytes", "Texture memory in use",
+        function() return graphicsStats.texturememory or 0 end)
+    Metrics.define("gauge", p .. "_lua_heap_bytes", "Lua heap size",
+        function() return collectgarbage("count") * 1024 end)
+    Metrics.define("counter", p .. "_gc_steps_total", "Incremental GC steps run in frame slack",
+        function() return GC.stats.stepsTotal end)
+    Metrics.define("counter", p .. "_gc_cycles_total", "GC cycles finished in frame slack",
+        function() return GC.stats.cycles end)
+    Metrics.define("gauge", p .. "_audio_voices", "Sources currently playing",
+        function() return love.audio.getActiveSourceCount() end)
+end
+
+function Metrics.update(dt)
+    if not Metrics.enabled then return end
+    timer = timer + dt
+    if timer >= Metrics.config.interval then
+        timer = timer - Metrics.config.interval
+        due = true
+    end
+end
+
+local function collect(drawn)
+    -- Nothing drawn (hidden window): no draw calls, memory as last read
+    if drawn then
+        love.graphics.getStats(graphicsStats)
+    else
+        graphicsStats.drawcalls = 0
+    end
+    frameSampled = false
+    for i = 1, count do
+        values[i] = readers[i]()
+    end
+end
+
+local function formatValue(v)
+    if v == math.floor(v) and math.abs(v) < 1e15 then
+        return string.format("%d", v)
+    end
+    return string.format("%.6g", v)
+end
+
+function Metrics.prometheusText()
+    local lines = {}
+    for i = 1, count do
+        if helps[i] then
+            lines[#lines + 1] = string.format("# HELP %s %s", names[i], helps[i])
+            lines[#lines + 1] = string.format("# TYPE %s %s", names[i], kinds[i])
+        end
+        local labelSet = labels[i] ~= "" and ("{" .. labels[i] .. "}") or ""
+        lines[#lines + 1] = names[i] .. labelSet .. " " .. formatValue(values[i])
+    end
+    return table.concat(lines, "\n") .. "\n"
+end
+
+function Metrics.statsdText()
+    local prefix = Metrics.config.prefix
+    local lines = {}
+    for i = 1, count do
+        lines[#lines + 1] = string.format("%s.%s:%s|g", prefix, statsd[i], formatValue(values[i]))
+    end
+    return table.concat(lines, "\n")
+end
+
+-- Write via a temp file and rename so scrapers never see half a file
+local function writeTextfile(path, text)
+    local tmp = path .. ".tmp"
+    local f, err = io.open(tmp, "w")
+    if not f then
+        print("Metrics: can't write " .. tmp .. ": " .. tostring(err))
+        return
+    end
+    f:write(text)
+    f:close()
+    os.remove(path)
+    os.rename(tmp, path)
+end
+
+-- Call once per frame, after drawing if the frame drew; exports when
+-- an interval is due
+function Metrics.flush(drawn)
+    if not due then return end
+    due = false
+
+    collect(drawn)
+    if Metrics.config.file then
+        writeTextfile(Metrics.config.file, Metrics.prometheusText())
+    end
+    if udp then
+        udp:send(Metrics.statsdText())
+    end
+    Metrics.exports = Metrics.exports + 1
+end
+
+return Metrics
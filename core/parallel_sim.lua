@@ -0,0 +1,167 @@
+-- Data-parallel entity simulation.
+-- Entity state lives in love.data ByteData buffers that every worker thread
+-- maps through FFI, so nothing is copied between threads. Each tick the
+-- main thread writes the tick parameters, wakes every worker, and waits on
+-- a shared "done" channel until all slices are finished (the barrier).
+--
+-- Benchmark prototype: only bench/parallel_sim.lua drives this. The
+-- game's enemies are still Enemy tables updated on the main thread,
+-- because takeDamage, effects, picking and drawing all read those tables
+-- directly; moving the live crowd here means giving Enemy a view onto
+-- its ByteData slot. hit() feeds damage in the way takeDamage does, so
+-- the benchmark covers the hit and death clips too.
+local Kernel = require("core.sim_kernel")
+
+local bit = require("bit")
+local band, bor = bit.band, bit.bor
+
+local ParallelSim = {}
+ParallelSim.__index = ParallelSim
+
+local WORKER_FILE = "core/sim_worker.lua"
+
+-- Build the clip table from an archetype's anims; one-shots take their
+-- transitions (`next`, `completes`) from the same data as Enemy:update
+local function buildClips(archetype)
+    local names = {}
+    for name in pairs(archetype.anims) do names[#names + 1] = name end
+    table.sort(names)
+
+    local index = {}
+    for i, name in ipairs(names) do index[name] = i - 1 end
+
+    local data = love.data.newByteData(#names * Kernel.CLIP_SIZE)
+    local clips = Kernel.castClips(data:getFFIPointer())
+
+    for i, name in ipairs(names) do
+        local a = archetype.anims[name]
+        local c = clips[i - 1]
+        c.speed = a.speed
+        c.frames = a.frames
+        c.loop = a.loop and 1 or 0
+        c.next = -1
+        c.doneFlags = 0
+        if not a.loop then
+            if a.next and index[a.next] then c.next = index[a.next] end
+            if a.completes then c.doneFlags = Kernel.DEATH_DONE end
+        end
+    end
+
+    return data, clips, index
+end
+
+function ParallelSim.new(archetype, capacity, workers)
+    local self = setmetatable({}, ParallelSim)
+
+    self.archetype = archetype
+    self.capacity = capacity
+    self.count = 0
+    self.workers = workers or math.max(0, love.system.getProcessorCount() - 1)
+
+    self.entityData = love.data.newByteData(capacity * Kernel.ENTITY_SIZE)
+    self.entities = Kernel.castEntities(self.entityData:getFFIPointer())
+
+    self.paramData = love.data.newByteData(Kernel.PARAMS_SIZE)
+    self.params = Kernel.castParams(self.paramData:getFFIPointer())
+
+    self.clipData, self.clips, self.clipIndex = buildClips(archetype)
+
+    self.threads = {}
+    self.ticks = {}
+    self.done = love.thread.newChannel()
+
+    for i = 1, self.workers do
+        local tick = love.thread.newChannel()
+        local thread = love.thread.newThread(WORKER_FILE)
+        thread:start(i - 1, self.workers, self.entityData, self.clipData,
+            self.paramData, tick, self.done)
+        self.threads[i] = thread
+        self.ticks[i] = tick
+    end
+
+    return self
+end
+
+-- Add an entity and return its slot (0-based, stable for its lifetime)
+function ParallelSim:add(x, y, clipName)
+    assert(self.count < self.capacity, "ParallelSim: capacity exceeded")
+
+    local i = self.count
+    local e = self.entities[i]
+    e.x, e.y = x, y
+    e.facingX, e.facingY = 1, 0
+    e.animTimer = 0
+    e.hitFlash = 0
+    e.animFrame = 1
+    e.clip = self.clipIndex[clipName or "idle"]
+    e.flags = Kernel.ALIVE + Kernel.PLAYING
+
+    self.count = i + 1
+    return i
+end
+
+function ParallelSim:entity(i)
+    return self.entities[i]
+end
+
+-- Damage from the main thread, between steps (workers are idle then):
+-- flash, and play the hit clip, or the death clip when `dead`
+function ParallelSim:hit(i, dead)
+    local e = self.entities[i]
+    if band(e.flags, Kernel.DEAD) ~= 0 then return end
+
+    e.hitFlash = self.archetype.hitFlash
+    local flags = bor(e.flags, Kernel.HIT)
+    local clip = self.clipIndex.hit
+    if dead then
+        flags = bor(flags, Kernel.DEAD)
+        clip = self.clipIndex.death
+    end
+
+    if clip and e.clip ~= clip then
+        e.clip = clip
+        e.animFrame, e.animTimer = 1, 0
+        flags = bor(flags, Kernel.PLAYING)
+    end
+    e.flags = flags
+end
+
+function ParallelSim:step(dt, playerX, playerY)
+    local p = self.params
+    p.dt = dt
+    p.playerX = playerX
+    p.playerY = playerY
+    p.count = self.count
+
+    if self.workers == 0 then
+        Kernel.step(self.entities, self.clips, 0, self.count - 1, dt, playerX, playerY)
+        return
+    end
+
+    for i = 1, self.workers do
+        self.ticks[i]:push(true)
+    end
+
+    -- Barrier: every worker reports once per tick
+    for _ = 1, self.workers do
+        if not self.done:demand(1) then
+            for i, thread in ipairs(self.threads) do
+                local err = thread:getError()
+                if err then error("sim worker " .. i .. ": " .. err) end
+            end
+            error("ParallelSim: worker timed out")
+        end
+    end
+end
+
+function ParallelSim:release()
+    for i, thread in ipairs(self.threads) do
+        self.ticks[i]:push("quit")
+        thread:wait()
+    end
+    self.threads = {}
+    self.ticks = {}
+    self.workers = 0
+end
+
+return ParallelSim
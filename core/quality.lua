@@ -0,0 +1,167 @@
+-- Graphics quality tiers.
+-- On first launch a short offscreen microbenchmark (floor mesh, batched
+-- enemy sprites, particles) picks a tier; the choice is saved to
+-- quality.txt in the save directory and reused afterwards. Delete that
+-- file, or pass --quality <tier>, to override.
+local Room = require("world.room")
+local Floor = require("world.floor")
+local Assets = require("core.assets")
+local Memory = require("core.memory")
+
+local Quality = {}
+
+local SAVE_FILE = "quality.txt"
+
+Quality.TIERS = {
+    low = {
+        -- Only x256p sheets ship today; lower tiers point here once they exist
+        spriteResolution = "x256p_Spritesheets",
+        particleBudget = 2,
+        floorMode = "flat",
+        shadows = false,
+    },
+    medium = {
+        spriteResolution = "x256p_Spritesheets",
+        particleBudget = 5,
+        floorMode = "outlined",
+        shadows = false,
+    },
+    high = {
+        spriteResolution = "x256p_Spritesheets",
+        particleBudget = 8,
+        floorMode = "outlined",
+        shadows = true,
+    },
+}
+
+-- Benchmark ms per frame at or under which a tier is chosen
+local THRESHOLDS = {
+    { tier = "high", ms = 4 },
+    { tier = "medium", ms = 10 },
+}
+
+local BENCH_W, BENCH_H = 1280, 720
+local BENCH_FRAMES = 20
+local BENCH_ENEMIES = 400
+local BENCH_PARTICLES = 2000
+
+Quality.tier = "medium"
+Quality.settings = Quality.TIERS.medium
+Quality.benchMs = nil
+
+-- Draw `fn` into the canvas BENCH_FRAMES times and wait for the GPU by
+-- reading one pixel back; returns ms per frame
+local function timeScene(canvas, fn)
+    local start = love.timer.getTime()
+    for _ = 1, BENCH_FRAMES do
+        love.graphics.setCanvas(canvas)
+        love.graphics.clear(0, 0, 0, 1)
+        fn()
+        love.graphics.setCanvas()
+    end
+    canvas:newImageData(1, 1, 0, 0, 1, 1):release()
+    return (love.timer.getTime() - start) * 1000 / BENCH_FRAMES
+end
+
+function Quality.benchmark()
+    love.graphics.push("all")
+    local canvas = love.graphics.newCanvas(BENCH_W, BENCH_H)
+
+    -- Floor: a large room's worth of tiles, fully outlined
+    local room = Room.new(60, 60)
+    room:generate()
+    local floor = Floor.new(room, 150, 96, "outlined")
+    local floorMs = timeScene(canvas, function()
+        love.graphics.draw(floor.fillMesh, BENCH_W / 2, -BENCH_H)
+        love.graphics.draw(floor.lineMesh, BENCH_W / 2, -BENCH_H)
+    end)
+
+    -- Enemies: one SpriteBatch of frames from a real sheet
+    local sheetPath = "assets/sprites/enemy/x256p_Spritesheets/Idle/Idle_Body_000.png"
+    local sheet = Assets.image(sheetPath)
+    local batch = love.graphics.newSpriteBatch(sheet, BENCH_ENEMIES, "static")
+    local quad = love.graphics.newQuad(0, 0, 256, 256, sheet:getDimensions())
+    for i = 1, BENCH_ENEMIES do
+        batch:add(quad, (i * 37) % BENCH_W, (i * 53) % BENCH_H, 0, 1.5, 1.5, 128, 128)
+    end
+    local enemyMs = timeScene(canvas, function() love.graphics.draw(batch) end)
+
+    -- Particles: alpha-blended soft quads
+    local dot = love.image.newImageData(8, 8)
+    dot:mapPixel(function() return 1, 1, 1, 1 end)
+    local dotImage = love.graphics.newImage(dot)
+    local particles = love.graphics.newParticleSystem(dotImage, BENCH_PARTICLES)
+    particles:setParticleLifetime(2, 4)
+    particles:setEmissionArea("uniform", BENCH_W / 2, BENCH_H / 2)
+    particles:setSizes(2, 4)
+    particles:setColors(1, 0.3, 0.1, 0.6, 1, 0.8, 0.2, 0)
+    particles:emit(BENCH_PARTICLES)
+    local particleMs = timeScene(canvas, function()
+        love.graphics.draw(particles, BENCH_W / 2, BENCH_H / 2)
+    end)
+
+    love.graphics.pop()
+
+    canvas:release()
+    batch:release()
+    Memory.untrack(sheet)
+    sheet:release()
+    particles:release()
+    dotImage:release()
+
+    local total = floorMs + enemyMs + particleMs
+    print(string.format("Quality: floor %.2f ms, enemies %.2f ms, particles %.2f ms",
+        floorMs, enemyMs, particleMs))
+    return total
+end
+
+local function pickTier(ms)
+    for _, t in ipairs(THRESHOLDS) do
+        if ms <= t.ms then return t.tier end
+    end
+    return "low"
+end
+
+function Quality.set(tier)
+    Quality.tier = tier
+    Quality.settings = Quality.TIERS[tier]
+end
+
+local function loadSaved()
+    if not love.filesystem.getInfo(SAVE_FILE) then return nil end
+
+    local saved = {}
+    for line in love.filesystem.lines(SAVE_FILE) do
+        local key, value = line:match("^(%w+)=(.*)$")
+        if key then saved[key] = value end
+    end
+    if Quality.TIERS[saved.tier] then return saved end
+    return nil
+end
+
+-- Pick the tier: --quality flag, then the saved choice, then a benchmark
+function Quality.init(args)
+    for i = 1, #(args or {}) do
+        if args[i] == "--quality" and Quality.TIERS[args[i + 1]] then
+            Quality.set(args[i + 1])
+            return
+        end
+    end
+
+    local saved = loadSaved()
+    if saved then
+        Quality.benchMs = tonumber(saved.benchMs)
+        Quality.set(saved.tier)
+        return
+    end
+
+    local ms = Quality.benchmark()
+    Quality.benchMs = ms
+    Quality.set(pickTier(ms))
+
+    love.filesystem.write(SAVE_FILE,
+        string.format("tier=%s\nbenchMs=%.3f\n", Quality.tier, ms))
+    print(string.format("Quality: %.2f ms per bench frame -> %s tier", ms, Quality.tier))
+end
+
+return Quality
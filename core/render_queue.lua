@@ -0,0 +1,328 @@
+-- Deferred draw commands.
+-- Call sites submit commands with a layer and depth instead of drawing
+-- straight to love.graphics. flush() sorts them by (layer, depth, texture,
+-- shader, blend, color), merges adjacent commands that share state into
+-- one run, and only touches love.graphics state when a run changes it.
+-- Commands are in iso-projected world pixels; flush() sorts once and then
+-- replays the list for each camera's viewport, culling per view.
+local RenderQueue = {}
+RenderQueue.__index = RenderQueue
+
+RenderQueue.LAYER_FLOOR    = 1
+RenderQueue.LAYER_DECALS   = 2
+RenderQueue.LAYER_ENTITIES = 3
+RenderQueue.LAYER_OVERLAY  = 4
+
+local BLEND_IDS = { alpha = 1, add = 2, multiply = 3, replace = 4, screen = 5 }
+
+local function blendId(mode, alphaMode)
+    local id = (BLEND_IDS[mode] or 0) * 2
+    if alphaMode == "premultiplied" then id = id + 1 end
+    return id
+end
+
+local DEFAULT_BLEND = blendId("alpha", "alphamultiply")
+
+-- Stable small ids for textures/shaders so the sort compares numbers
+local textureIds = setmetatable({}, { __mode = "k" })
+local shaderIds = setmetatable({}, { __mode = "k" })
+local nextTextureId, nextShaderId = 1, 1
+
+local function textureId(tex)
+    if not tex then return 0 end
+    local id = textureIds[tex]
+    if not id then
+        id = nextTextureId
+        nextTextureId = nextTextureId + 1
+        textureIds[tex] = id
+    end
+    return id
+end
+
+local function shaderId(shader)
+    if not shader then return 0 end
+    local id = shaderIds[shader]
+    if not id then
+        id = nextShaderId
+        nextShaderId = nextShaderId + 1
+        shaderIds[shader] = id
+    end
+    return id
+end
+
+-- 8 bits per channel, enough to tell colors apart for merging
+local function colorKey(r, g, b, a)
+    return math.floor(r * 255 + 0.5) * 16777216
+        + math.floor(g * 255 + 0.5) * 65536
+        + math.floor(b * 255 + 0.5) * 256
+        + math.floor(a * 255 + 0.5)
+end
+
+local function compare(a, b)
+    if a.layer ~= b.layer then return a.layer < b.layer end
+    if a.depth ~= b.depth then return a.depth < b.depth end
+    if a.texId ~= b.texId then return a.texId < b.texId end
+    if a.shaderId ~= b.shaderId then return a.shaderId < b.shaderId end
+    if a.blendId ~= b.blendId then return a.blendId < b.blendId end
+    if a.colorKey ~= b.colorKey then return a.colorKey < b.colorKey end
+    return a.seq < b.seq
+end
+
+function RenderQueue.new()
+    local self = setmetatable({}, RenderQueue)
+
+    self.commands = {}  -- pooled command tables, reused every frame
+    self.order = {}
+    self.count = 0
+
+    -- Submit state, applied to every command until changed
+    self.r, self.g, self.b, self.a = 1, 1, 1, 1
+    self.shader = nil
+    self.blend = "alpha"
+    self.alphaMode = "alphamultiply"
+
+    self.stats = {
+        commands = 0,
+        runs = 0,
+        colorChanges = 0,
+        textureChanges = 0,
+        shaderChanges = 0,
+        blendChanges = 0,
+        views = 0,
+        culled = 0,
+    }
+
+    return self
+end
+
+function RenderQueue:begin()
+    self.count = 0
+    self.r, self.g, self.b, self.a = 1, 1, 1, 1
+    self.shader = nil
+    self.blend = "alpha"
+    self.alphaMode = "alphamultiply"
+end
+
+function RenderQueue:setColor(r, g, b, a)
+    self.r, self.g, self.b, self.a = r, g, b, a or 1
+end
+
+function RenderQueue:setShader(shader)
+    self.shader = shader
+end
+
+function RenderQueue:setBlendMode(mode, alphaMode)
+    self.blend = mode
+    self.alphaMode = alphaMode or "alphamultiply"
+end
+
+function RenderQueue:push(kind, layer, depth, texture)
+    local n = self.count + 1
+    self.count = n
+
+    local cmd = self.commands[n]
+    if not cmd then
+        cmd = {}
+        self.commands[n] = cmd
+    end
+
+    cmd.kind = kind
+    cmd.layer = layer
+    cmd.depth = depth
+    cmd.seq = n
+    cmd.texture = texture
+    cmd.texId = textureId(texture)
+    cmd.shader = self.shader
+    cmd.shaderId = shaderId(self.shader)
+    cmd.blend = self.blend
+    cmd.alphaMode = self.alphaMode
+    cmd.blendId = blendId(self.blend, self.alphaMode)
+    cmd.r, cmd.g, cmd.b, cmd.a = self.r, self.g, self.b, self.a
+    cmd.colorKey = colorKey(self.r, self.g, self.b, self.a)
+    cmd.x0, cmd.y0, cmd.x1, cmd.y1 = -math.huge, -math.huge, math.huge, math.huge
+
+    return cmd
+end
+
+local function setBounds(cmd, x0, y0, x1, y1)
+    cmd.x0, cmd.y0, cmd.x1, cmd.y1 = x0, y0, x1, y1
+end
+
+-- Four-corner polygon (iso tiles)
+function RenderQueue:quad(layer, depth, mode, x1, y1, x2, y2, x3, y3, x4, y4)
+    local cmd = self:push("quad", layer, depth, nil)
+    cmd.mode = mode
+    cmd.px1, cmd.py1, cmd.px2, cmd.py2 = x1, y1, x2, y2
+    cmd.px3, cmd.py3, cmd.px4, cmd.py4 = x3, y3, x4, y4
+    setBounds(cmd,
+        math.min(x1, x2, x3, x4), math.min(y1, y2, y3, y4),
+        math.max(x1, x2, x3, x4), math.max(y1, y2, y3, y4))
+end
+
+function RenderQueue:sprite(layer, depth, texture, quad, x, y, rot, sx, sy, ox, oy)
+    local cmd = self:push("sprite", layer, depth, texture)
+    cmd.mode = nil
+    cmd.quad = quad
+    cmd.x, cmd.y = x, y
+    cmd.rot = rot or 0
+    cmd.sx, cmd.sy = sx or 1, sy or sx or 1
+    cmd.ox, cmd.oy = ox or 0, oy or 0
+
+    -- Bounds for culling (rotation ignored); meshes have no size
+    local w, h
+    if quad then
+        local _
+        _, _, w, h = quad:getViewport()
+    elseif texture:typeOf("Texture") then
+        w, h = texture:getDimensions()
+    end
+    if w then
+        local left, top = x - cmd.ox * cmd.sx, y - cmd.oy * cmd.sy
+        setBounds(cmd, left, top, left + w * cmd.sx, top + h * cmd.sy)
+    end
+end
+
+-- Mesh drawn at (x, y) with known local bounds, so it can be culled
+function RenderQueue:mesh(layer, depth, mesh, x, y, bx0, by0, bx1, by1)
+    local cmd = self:push("sprite", layer, depth, mesh)
+    cmd.mode = nil
+    cmd.quad = nil
+    cmd.x, cmd.y = x, y
+    cmd.rot = 0
+    cmd.sx, cmd.sy = 1, 1
+    cmd.ox, cmd.oy = 0, 0
+    setBounds(cmd, x + bx0, y + by0, x + bx1, y + by1)
+end
+
+function RenderQueue:circle(layer, depth, mode, x, y, radius)
+    local cmd = self:push("circle", layer, depth, nil)
+    cmd.mode = mode
+    cmd.x, cmd.y = x, y
+    cmd.radius = radius
+    setBounds(cmd, x - radius, y - radius, x + radius, y + radius)
+end
+
+function RenderQueue:ellipse(layer, depth, mode, x, y, rx, ry)
+    local cmd = self:push("ellipse", layer, depth, nil)
+    cmd.mode = mode
+    cmd.x, cmd.y = x, y
+    cmd.rx, cmd.ry = rx, ry
+    setBounds(cmd, x - rx, y - ry, x + rx, y + ry)
+end
+
+local function resetStats(stats)
+    stats.runs = 0
+    stats.colorChanges = 0
+    stats.textureChanges = 0
+    stats.shaderChanges = 0
+    stats.blendChanges = 0
+    stats.views = 0
+    stats.culled = 0
+end
+
+-- Replay the sorted commands that intersect the world-pixel rect
+function RenderQueue:replay(cx0, cy0, cx1, cy1)
+    local order = self.order
+    local stats = self.stats
+    local lg = love.graphics
+
+    local curColor, curShader, curTex = nil, nil, nil
+    local curBlend = DEFAULT_BLEND
+    local prev = nil
+
+    for i = 1, self.count do
+        local cmd = order[i]
+
+        if cmd.x1 < cx0 or cmd.x0 > cx1 or cmd.y1 < cy0 or cmd.y0 > cy1 then
+            stats.culled = stats.culled + 1
+        else
+            -- A new run starts whenever any piece of state differs
+            if not prev or prev.colorKey ~= cmd.colorKey or prev.texId ~= cmd.texId
+                or prev.shaderId ~= cmd.shaderId or prev.blendId ~= cmd.blendId
+                or prev.kind ~= cmd.kind or prev.mode ~= cmd.mode then
+                stats.runs = stats.runs + 1
+            end
+
+            if cmd.colorKey ~= curColor then
+                lg.setColor(cmd.r, cmd.g, cmd.b, cmd.a)
+                curColor = cmd.colorKey
+                stats.colorChanges = stats.colorChanges + 1
+            end
+            if cmd.shader ~= curShader then
+                lg.setShader(cmd.shader)
+                curShader = cmd.shader
+                stats.shaderChanges = stats.shaderChanges + 1
+            end
+            if cmd.blendId ~= curBlend then
+                lg.setBlendMode(cmd.blend, cmd.alphaMode)
+                curBlend = cmd.blendId
+                stats.blendChanges = stats.blendChanges + 1
+            end
+            if cmd.texture and cmd.texture ~= curTex then
+                curTex = cmd.texture
+                stats.textureChanges = stats.textureChanges + 1
+            end
+
+            local kind = cmd.kind
+            if kind == "sprite" then
+                if cmd.quad then
+                    lg.draw(cmd.texture, cmd.quad, cmd.x, cmd.y, cmd.rot, cmd.sx, cmd.sy, cmd.ox, cmd.oy)
+                else
+                    lg.draw(cmd.texture, cmd.x, cmd.y, cmd.rot, cmd.sx, cmd.sy, cmd.ox, cmd.oy)
+                end
+            elseif kind == "quad" then
+                lg.polygon(cmd.mode, cmd.px1, cmd.py1, cmd.px2, cmd.py2,
+                    cmd.px3, cmd.py3, cmd.px4, cmd.py4)
+            elseif kind == "circle" then
+                lg.circle(cmd.mode, cmd.x, cmd.y, cmd.radius)
+            elseif kind == "ellipse" then
+                lg.ellipse(cmd.mode, cmd.x, cmd.y, cmd.rx, cmd.ry)
+            end
+
+            prev = cmd
+        end
+    end
+
+    lg.setColor(1, 1, 1, 1)
+    if curShader then lg.setShader() end
+    if curBlend ~= DEFAULT_BLEND then lg.setBlendMode("alpha") end
+end
+
+-- Sort once, then draw into each camera's viewport
+function RenderQueue:flush(cameras)
+    local order = self.order
+    local count = self.count
+
+    for i = 1, count do order[i] = self.commands[i] end
+    for i = #order, count + 1, -1 do order[i] = nil end
+
+    table.sort(order, compare)
+
+    local stats = self.stats
+    stats.commands = count
+    resetStats(stats)
+
+    local lg = love.graphics
+    for _, cam in ipairs(cameras) do
+        stats.views = stats.views + 1
+
+        lg.push()
+        lg.setScissor(cam.viewX, cam.viewY, cam.viewW, cam.viewH)
+        lg.translate(cam.viewX + cam.x, cam.viewY + cam.y)
+
+        self:replay(-cam.x, -cam.y, -cam.x + cam.viewW, -cam.y + cam.viewH)
+
+        lg.setScissor()
+        lg.pop()
+    end
+
+    -- Drop references so freed textures aren't pinned by the pool
+    for i = 1, count do
+        local cmd = order[i]
+        cmd.texture, cmd.quad, cmd.shader = nil, nil, nil
+    end
+
+    self.count = 0
+end
+
+return RenderQueue
@@ -0,0 +1,111 @@
+-- Per-tick entity update over FFI arrays.
+-- Shared by the main thread and the sim workers (core/sim_worker.lua), so
+-- it must only depend on LuaJIT builtins, never on love.* modules.
+local ffi = require("ffi")
+local bit = require("bit")
+
+local band, bor, bnot = bit.band, bit.bor, bit.bnot
+local sqrt = math.sqrt
+
+ffi.cdef [[
+typedef struct {
+    double animTimer;  /* double so frame boundaries match Enemy:update */
+    float x, y;
+    float facingX, facingY;
+    float hitFlash;
+    int32_t animFrame;
+    int32_t clip;
+    int32_t flags;
+} sim_entity_t;
+
+typedef struct {
+    double speed;
+    int32_t frames;
+    int32_t loop;
+    int32_t next;      /* clip to switch to when a one-shot ends, -1 = stay */
+    int32_t doneFlags; /* flags raised when a one-shot ends without switching */
+} sim_clip_t;
+
+typedef struct {
+    double dt;
+    float playerX, playerY;
+    int32_t count;
+} sim_params_t;
+]]
+
+local Kernel = {}
+
+Kernel.ALIVE        = 1
+Kernel.PLAYING      = 2
+Kernel.HIT          = 4
+Kernel.DEAD         = 8
+Kernel.DEATH_DONE   = 16
+
+local PLAYING, HIT, ALIVE, DEAD = Kernel.PLAYING, Kernel.HIT, Kernel.ALIVE, Kernel.DEAD
+
+Kernel.ENTITY_SIZE = ffi.sizeof("sim_entity_t")
+Kernel.CLIP_SIZE   = ffi.sizeof("sim_clip_t")
+Kernel.PARAMS_SIZE = ffi.sizeof("sim_params_t")
+
+function Kernel.castEntities(ptr) return ffi.cast("sim_entity_t*", ptr) end
+function Kernel.castClips(ptr) return ffi.cast("sim_clip_t*", ptr) end
+function Kernel.castParams(ptr) return ffi.cast("sim_params_t*", ptr) end
+
+-- Enemy:update's rules: face the player, tick the hit flash and advance
+-- the animation clock, switching clips when one-shots end. Unlike Enemy,
+-- looping clips are advanced per entity here (no shared AnimClock).
+function Kernel.step(ents, clips, first, last, dt, px, py)
+    for i = first, last do
+        local e = ents[i]
+        local flags = e.flags
+
+        if band(flags, ALIVE) ~= 0 then
+            local dx, dy = px - e.x, py - e.y
+            local len = sqrt(dx * dx + dy * dy)
+            if len > 0.001 then
+                e.facingX = dx / len
+                e.facingY = dy / len
+            end
+
+            if band(flags, HIT) ~= 0 then
+                local flash = e.hitFlash - dt
+                e.hitFlash = flash
+                if flash <= 0 then
+                    flags = band(flags, bnot(HIT))
+                end
+            end
+
+            if band(flags, PLAYING) ~= 0 then
+                local c = clips[e.clip]
+                local t = e.animTimer + dt
+                local f = e.animFrame
+                while t >= c.speed do
+                    t = t - c.speed
+                    f = f + 1
+                    if f > c.frames then
+                        if c.loop ~= 0 then
+                            f = 1
+                        else
+                            f = c.frames
+                            flags = band(flags, bnot(PLAYING))
+                            if c.next >= 0 and band(flags, DEAD) == 0 then
+                                e.clip = c.next
+                                f, t = 1, 0
+                                flags = bor(flags, PLAYING)
+                            else
+                                flags = bor(flags, c.doneFlags)
+                            end
+                            break
+                        end
+                    end
+                end
+                e.animTimer = t
+                e.animFrame = f
+            end
+
+            e.flags = flags
+        end
+    end
+end
+
+return Kernel
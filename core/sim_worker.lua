@@ -0,0 +1,29 @@
+-- Thread body for ParallelSim. Maps the shared ByteData buffers through
+-- FFI once, then runs one slice of the entity array per tick message.
+require("love.filesystem")
+require("love.data")
+
+local Kernel = require("core.sim_kernel")
+
+local index, workers, entityData, clipData, paramData, tick, done = ...
+
+local ents   = Kernel.castEntities(entityData:getFFIPointer())
+local clips  = Kernel.castClips(clipData:getFFIPointer())
+local params = Kernel.castParams(paramData:getFFIPointer())
+
+while true do
+    local msg = tick:demand()
+    if msg == "quit" then break end
+
+    -- Contiguous slice so each worker walks its own cache lines
+    local count = params.count
+    local per = math.ceil(count / workers)
+    local first = index * per
+    local last = math.min(count, first + per) - 1
+
+    if first <= last then
+        Kernel.step(ents, clips, first, last, params.dt, params.playerX, params.playerY)
+    end
+
+    done:push(index)
+end
@@ -0,0 +1,69 @@
+-- Background throttling.
+-- Unfocused: the loop drops to a low update/render rate and audio is
+-- turned down. Hidden (minimized): rendering stops entirely, the update
+-- rate drops further and audio is paused (no new sounds start either).
+-- Game time is never lost: love.update gets the full elapsed time once,
+-- and the loop feeds it to the clocks in love.tick in substeps of at
+-- most maxStep.
+local Throttle = {
+    focused = true,
+    visible = true,
+
+    config = {
+        unfocusedHz = 15,
+        hiddenHz = 4,
+        unfocusedVolume = 0.25,
+        maxStep = 1 / 30,  -- largest dt a single love.tick may see
+    },
+
+    pausedSources = nil,
+    volume = nil,
+}
+
+function Throttle.isActive()
+    return not (Throttle.focused and Throttle.visible)
+end
+
+function Throttle.shouldDraw()
+    return Throttle.visible
+end
+
+-- Frame rate the loop should pace to while throttled, nil when not
+function Throttle.rate()
+    if not Throttle.visible then return Throttle.config.hiddenHz end
+    if not Throttle.focused then return Throttle.config.unfocusedHz end
+    return nil
+end
+
+local function applyAudio()
+    if not Throttle.visible then
+        if not Throttle.pausedSources then
+            Throttle.pausedSources = love.audio.pause()
+        end
+    elseif Throttle.pausedSources then
+        love.audio.play(Throttle.pausedSources)
+        Throttle.pausedSources = nil
+    end
+
+    if not Throttle.focused then
+        if not Throttle.volume then
+            Throttle.volume = love.audio.getVolume()
+            love.audio.setVolume(Throttle.volume * Throttle.config.unfocusedVolume)
+        end
+    elseif Throttle.volume then
+        love.audio.setVolume(Throttle.volume)
+        Throttle.volume = nil
+    end
+end
+
+function Throttle.setFocused(focused)
+    Throttle.focused = focused
+    applyAudio()
+end
+
+function Throttle.setVisible(visible)
+    Throttle.visible = visible
+    applyAudio()
+end
+
+return Throttle
@@ -1,4 +1,9 @@
 local Iso = require("core.iso")
+local Archetypes = require("core.archetypes")
+local RenderQueue = require("core.render_queue")
+local Quality = require("core.quality")
+local Assets = require("core.assets")
+local AnimClock = require("core.anim_clock")
 
 local Enemy = {}
 Enemy.__index = Enemy
@@ -29,8 +34,6 @@ local ANGLE_TO_SUFFIX = {
     [337.5] = "337"
 }
 
--- Resolution to use
-local SPRITE_RESOLUTION = "x256p_Spritesheets"
 
 -- Spritesheet grid layouts for each animation type (columns x rows)
 local ANIM_GRID_LAYOUTS = {
@@ -63,10 +66,10 @@ local function loadEnemySprites()
         for _, angle in ipairs(SPRITE_ANGLES) do
             local suffix = ANGLE_TO_SUFFIX[angle]
             local path = string.format("assets/sprites/enemy/%s/%s/%s_Body_%s.png",
-                SPRITE_RESOLUTION, animType, animType, suffix)
+                Quality.settings.spriteResolution, animType, animType, suffix)
 
             -- Load spritesheet image
-            local success, spritesheet = pcall(love.graphics.newImage, path)
+            local success, spritesheet = pcall(Assets.image, path)
             if success then
                 spritesheet:setFilter("nearest", "nearest")
                 loadedSpritesheets[animType][angle] = spritesheet
@@ -107,6 +110,12 @@ local function loadEnemySprites()
     return loadedSprites, loadedSpritesheets
 end
 
+-- Decode every enemy sheet now rather than on the first spawn, which
+-- the director makes mid-game
+function Enemy.preload()
+    loadEnemySprites()
+end
+
 function Enemy:getDirectionAngle(dx, dy)
     -- Same calculation as player for consistency
     local angle = math.deg(math.atan2(dy, dx))
@@ -140,43 +149,26 @@ end
 function Enemy.new(x, y)
     local self = setmetatable({}, Enemy)
 
+    -- Constant data (anims, scale, tuning) lives on the shared archetype
+    self.archetype = Archetypes.enemy
+
     -- Load sprites (shared cache)
-    self.sprites, self.spritesheets = loadEnemySprites()
-
-    -- Scale
-    self.spriteScale = 1.5
-
-    -- Animation definitions
-    self.anims = {
-        idle = {
-            frames = 20,   -- 5x4 = 20 frames
-            speed = 0.15,  -- 0.15s per frame
-            loop = true
-        },
-        hit = {
-            frames = 16,   -- 4x4 = 16 frames
-            speed = 0.05,  -- 0.05s per frame = 0.8s total (quick hit reaction)
-            loop = false
-        },
-        death = {
-            frames = 30,   -- 6x5 = 30 frames
-            speed = 0.08,  -- 0.08s per frame = 2.4s total
-            loop = false
-        }
-    }
+    loadEnemySprites()
 
+    -- Looping clips (idle) run off a shared clock plus `phase`; a random
+    -- phase keeps a crowd from animating in lockstep
+    local idle = self.archetype.anims.idle
     self.anim = {
         name = "idle",
         frame = 1,
         timer = 0,
-        playing = true
+        playing = true,
+        phase = AnimClock.phaseFor(idle, love.math.random() * idle.frames * idle.speed)
     }
 
     self.x = x
     self.y = y
-    self.hp = 3
-    self.size = 20  -- collision size
-    self.hitRange = 1.5  -- reduced from larger values
+    self.hp = self.archetype.maxHp
 
     self.isHit = false
     self.hitFlash = 0
@@ -196,20 +188,35 @@ function Enemy:setAnim(name)
         self.anim.frame = 1
         self.anim.timer = 0
         self.anim.playing = true
+
+        local a = self.archetype.anims[name]
+        if a and a.loop then
+            self.anim.phase = AnimClock.phaseFor(a)
+        end
+    end
+end
+
+-- Current frame; looping clips derive it from the shared clock
+function Enemy:getFrame()
+    local a = self.archetype.anims[self.anim.name]
+    if a and a.loop then
+        return AnimClock.frame(a, self.anim.phase)
     end
+    return self.anim.frame
 end
 
-function Enemy:takeDamage(dmg)
+-- quiet: flash but skip the hit reaction (damage over time)
+function Enemy:takeDamage(dmg, quiet)
     if self.dead then return end
 
     self.hp = self.hp - dmg
     self.isHit = true
-    self.hitFlash = 0.1
+    self.hitFlash = self.archetype.hitFlash
 
     if self.hp <= 0 then
         self.dead = true
         self:setAnim("death")
-    else
+    elseif not quiet then
         self:setAnim("hit")
     end
 end
@@ -224,6 +231,8 @@ function Enemy:facePlayer(playerX, playerY)
     end
 end
 
+-- Generic path; main swaps in a version specialised to the archetype
+-- (core/archetype_compiler.lua), which must stay equivalent to this
 function Enemy:update(dt, player)
     -- Always face the player
     if player then
@@ -238,42 +247,31 @@ function Enemy:update(dt, player)
         end
     end
 
-    -- Update animation frame
-    local a = self.anims[self.anim.name]
-    if a and self.anim.playing then
+    -- Update animation frame (one-shots only; loops use AnimClock)
+    local a = self.archetype.anims[self.anim.name]
+    if a and not a.loop and self.anim.playing then
         self.anim.timer = self.anim.timer + dt
         while self.anim.timer >= a.speed do
             self.anim.timer = self.anim.timer - a.speed
             self.anim.frame = self.anim.frame + 1
 
             if self.anim.frame > a.frames then
-                if a.loop then
-                    self.anim.frame = 1
-                else
-                    self.anim.frame = a.frames  -- Stay on last frame
-                    self.anim.playing = false
-                    -- Transition after non-looping animations
-                    if self.anim.name == "hit" and not self.dead then
-                        self:setAnim("idle")
-                    elseif self.anim.name == "death" then
-                        self.deathAnimComplete = true
-                    end
+                self.anim.frame = a.frames  -- Stay on last frame
+                self.anim.playing = false
+                -- Transition after non-looping animations
+                if a.next and not self.dead then
+                    self:setAnim(a.next)
+                elseif a.completes then
+                    self.deathAnimComplete = true
                 end
+                break
             end
         end
     end
 end
 
-function Enemy:draw(iso, camera)
-    -- Don't draw if death animation is complete
-    if self.deathAnimComplete then return end
-
-    local sx, sy = iso(self.x, self.y)
-
-    -- Apply camera
-    sx = sx + camera.x
-    sy = sy + camera.y
-
+-- Spritesheet and quad for the current animation frame and facing
+function Enemy:getSprite()
     -- Determine sprite set based on animation state
     local spriteSet = "Idle"
     if self.anim.name == "hit" then
@@ -290,30 +288,65 @@ function Enemy:draw(iso, camera)
     local spritesheet = nil
     local quad = nil
 
-    if self.spritesheets[spriteSet] and self.spritesheets[spriteSet][spriteAngle] then
-        spritesheet = self.spritesheets[spriteSet][spriteAngle]
-        if self.sprites[spriteSet] and self.sprites[spriteSet][spriteAngle] then
-            local a = self.anims[self.anim.name]
+    local sprites, spritesheets = loadedSprites, loadedSpritesheets
+
+    if spritesheets[spriteSet] and spritesheets[spriteSet][spriteAngle] then
+        spritesheet = spritesheets[spriteSet][spriteAngle]
+        if sprites[spriteSet] and sprites[spriteSet][spriteAngle] then
+            local a = self.archetype.anims[self.anim.name]
             local maxFrames = a and a.frames or 20
-            local frameIndex = math.max(1, math.min(self.anim.frame, maxFrames))
-            quad = self.sprites[spriteSet][spriteAngle][frameIndex]
+            local frameIndex = math.max(1, math.min(self:getFrame(), maxFrames))
+            quad = sprites[spriteSet][spriteAngle][frameIndex]
         end
     end
 
     -- Fallback to Idle if sprite not found
-    if not spritesheet and self.spritesheets["Idle"] then
+    if not spritesheet and spritesheets["Idle"] then
         local fallbackAngle = spriteAngle or SPRITE_ANGLES[1]
-        spritesheet = self.spritesheets["Idle"][fallbackAngle]
-        if self.sprites["Idle"] and self.sprites["Idle"][fallbackAngle] then
-            quad = self.sprites["Idle"][fallbackAngle][1]
+        spritesheet = spritesheets["Idle"][fallbackAngle]
+        if sprites["Idle"] and sprites["Idle"][fallbackAngle] then
+            quad = sprites["Idle"][fallbackAngle][1]
         end
     end
 
+    return spritesheet, quad
+end
+
+-- highlight: draw a ring at the feet (cursor hover)
+-- impostor: distant LOD, one fixed frame shared by every impostor so
+-- they all land in the same texture batch
+function Enemy:draw(iso, queue, highlight, impostor)
+    -- Corpses are baked into the decal layer once the death anim ends
+    if self.deathAnimComplete then return end
+
+    -- World pixels; the render queue applies each view's camera
+    local sx, sy = iso(self.x, self.y)
+
+    local arch = self.archetype
+    local spritesheet, quad
+    if impostor and not self.dead and loadedSpritesheets.Idle[0] then
+        spritesheet, quad = loadedSpritesheets.Idle[0], loadedSprites.Idle[0][1]
+    else
+        spritesheet, quad = self:getSprite()
+    end
+
+    if Quality.settings.shadows then
+        queue:setColor(0, 0, 0, 0.35)
+        queue:ellipse(RenderQueue.LAYER_DECALS, 1, "fill",
+            sx, sy + arch.shadowOffset, arch.shadowRadius, arch.shadowRadius * 0.4)
+    end
+
+    if highlight then
+        queue:setColor(1, 0.85, 0.2, 0.9)
+        queue:ellipse(RenderQueue.LAYER_DECALS, 1, "line",
+            sx, sy + arch.shadowOffset, arch.shadowRadius, arch.shadowRadius * 0.4)
+    end
+
     -- Apply hit flash tint
     if self.isHit then
-        love.graphics.setColor(1, 0.5, 0.5, 1)
+        queue:setColor(1, 0.5, 0.5, 1)
     else
-        love.graphics.setColor(1, 1, 1, 1)
+        queue:setColor(1, 1, 1, 1)
     end
 
     if spritesheet and quad then
@@ -321,24 +354,24 @@ function Enemy:draw(iso, camera)
         local _, _, frameW, frameH = quad:getViewport()
 
         -- Draw sprite centered
-        love.graphics.draw(
+        queue:sprite(
+            RenderQueue.LAYER_ENTITIES,
+            self.x + self.y,  -- iso draw order
             spritesheet,
             quad,
             sx,
             sy,
             0,
-            self.spriteScale,
-            self.spriteScale,
+            arch.spriteScale,
+            arch.spriteScale,
             frameW / 2,
             frameH / 2
         )
     else
         -- Fallback: draw a simple circle if sprites aren't loaded
-        love.graphics.setColor(1, 0, 0, 1)
-        love.graphics.circle("fill", sx, sy, self.size)
+        queue:setColor(1, 0, 0, 1)
+        queue:circle(RenderQueue.LAYER_ENTITIES, self.x + self.y, "fill", sx, sy, arch.size)
     end
-
-    love.graphics.setColor(1, 1, 1, 1)
 end
 
 return Enemy
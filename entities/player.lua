@@ -1,5 +1,9 @@
 local Mace = require("weapons.mace")
 local Iso = require("core.iso")
+local Archetypes = require("core.archetypes")
+local RenderQueue = require("core.render_queue")
+local Quality = require("core.quality")
+local Assets = require("core.assets")
 
 
 local Player = {}
@@ -31,8 +35,6 @@ local ANGLE_TO_SUFFIX = {
     [337.5] = "337"
 }
 
--- Resolution to use (x256p seems like a good middle ground)
-local SPRITE_RESOLUTION = "x256p_Spritesheets"
 
 -- Spritesheet grid layouts for each animation type (columns x rows)
 local ANIM_GRID_LAYOUTS = {
@@ -43,16 +45,22 @@ local ANIM_GRID_LAYOUTS = {
     Attack_Jump = { cols = 6, rows = 4 },    -- 6x4 = 24 frames (right-click)
 }
 
-function Player:loadSprites()
-    self.sprites = {}
-    self.spritesheets = {}
+-- Static sprite cache (shared across all players)
+local loadedSprites = nil
+local loadedSpritesheets = nil
+
+local function loadPlayerSprites()
+    if loadedSprites then return loadedSprites, loadedSpritesheets end
+
+    loadedSprites = {}
+    loadedSpritesheets = {}
 
     -- Load spritesheets for each animation type
     local animTypes = { "Idle", "Walk", "Run", "Attack_Swipe", "Attack_Jump" }
 
     for _, animType in ipairs(animTypes) do
-        self.sprites[animType] = {}
-        self.spritesheets[animType] = {}
+        loadedSprites[animType] = {}
+        loadedSpritesheets[animType] = {}
 
         -- Get grid layout for this animation type
         local layout = ANIM_GRID_LAYOUTS[animType] or { cols = 4, rows = 4 }
@@ -62,20 +70,20 @@ function Player:loadSprites()
         for _, angle in ipairs(SPRITE_ANGLES) do
             local suffix = ANGLE_TO_SUFFIX[angle]
             local path = string.format("assets/sprites/player/%s/%s/%s_Body_%s.png",
-                SPRITE_RESOLUTION, animType, animType, suffix)
+                Quality.settings.spriteResolution, animType, animType, suffix)
 
             -- Load spritesheet image
-            local success, spritesheet = pcall(love.graphics.newImage, path)
+            local success, spritesheet = pcall(Assets.image, path)
             if success then
                 spritesheet:setFilter("nearest", "nearest")
-                self.spritesheets[animType][angle] = spritesheet
+                loadedSpritesheets[animType][angle] = spritesheet
 
                 local sheetW = spritesheet:getWidth()
                 local sheetH = spritesheet:getHeight()
                 local frameW = sheetW / framesPerRow
                 local frameH = sheetH / framesPerCol
 
-                self.sprites[animType][angle] = {}
+                loadedSprites[animType][angle] = {}
                 for row = 0, framesPerCol - 1 do
                     for col = 0, framesPerRow - 1 do
                         local frameIndex = row * framesPerRow + col + 1
@@ -87,7 +95,7 @@ function Player:loadSprites()
                             sheetW,
                             sheetH
                         )
-                        self.sprites[animType][angle][frameIndex] = quad
+                        loadedSprites[animType][angle][frameIndex] = quad
                     end
                 end
             else
@@ -97,11 +105,13 @@ function Player:loadSprites()
     end
 
     -- Debug: print loaded spritesheet counts
-    for animType, sheets in pairs(self.spritesheets) do
+    for animType, sheets in pairs(loadedSpritesheets) do
         local count = 0
         for _ in pairs(sheets) do count = count + 1 end
         print(string.format("Loaded %d spritesheets for %s", count, animType))
     end
+
+    return loadedSprites, loadedSpritesheets
 end
 
 function Player:getDirectionAngle(dx, dy)
@@ -144,42 +154,11 @@ end
 function Player.new(x, y)
     local self = setmetatable({}, Player)
 
-    -- Load directional sprites
-    self:loadSprites()
-
-    -- scale (tweak later)
-    self.spriteScale = 1.2
-
-    -- animation definitions (frames per animation)
-    -- Frame counts match the grid layouts defined in ANIM_GRID_LAYOUTS
-    -- Speed is time per frame in seconds (higher = slower animation)
-    self.anims       = {
-        idle = {
-            frames = 16,   -- 4x4 = 16 frames
-            speed = 0.2,   -- 0.2s per frame = 3.2s total cycle
-            loop = true    -- Continuously loop
-        },
-        walk = {
-            frames = 20,   -- 5x4 = 20 frames
-            speed = 0.08,  -- 0.08s per frame = 1.6s total cycle
-            loop = true    -- Continuously loop
-        },
-        run = {
-            frames = 16,   -- 4x4 = 16 frames (used for dash)
-            speed = 0.06,  -- 0.06s per frame = 0.96s total cycle
-            loop = true    -- Continuously loop
-        },
-        attack_swipe = {
-            frames = 20,   -- 5x4 = 20 frames (Attack_Swipe)
-            speed = 0.1,   -- 0.1s per frame = 2s total (slow sweep)
-            loop = false   -- Play once, then return to idle
-        },
-        attack_jump = {
-            frames = 24,   -- 6x4 = 24 frames (Attack_Jump)
-            speed = 0.1,   -- 0.1s per frame = 2.4s total (slow jump)
-            loop = false   -- Play once, then return to idle
-        }
-    }
+    -- Constant data (anims, scale, speeds) lives on the shared archetype
+    self.archetype = Archetypes.player
+
+    -- Load directional sprites (shared cache)
+    loadPlayerSprites()
 
     self.anim        = {
         name = "idle",
@@ -193,8 +172,6 @@ function Player.new(x, y)
 
     self.x = x
     self.y = y
-    self.speed = 3
-    self.size = 15
 
     -- direction
     self.facing = { x = 1, y = 0 } -- movement / aim vector
@@ -204,8 +181,6 @@ function Player.new(x, y)
     -- dash
     self.isDashing = false
     self.dashTime = 0
-    self.dashDuration = 0.15
-    self.dashSpeed = 10
     self.dashDX = 0
     self.dashDY = 0
     self.invulnerable = false
@@ -231,15 +206,22 @@ function Player:setDirection(newAngle)
     self.lastSpriteAngle = newAngle
 end
 
-function Player:updateAim(camera, tileW, tileH)
-    local mx, my = love.mouse.getPosition()
+-- target: entity under the cursor, if any; aim locks onto its ground
+-- point rather than wherever the cursor ray meets the floor
+function Player:updateAim(camera, tileW, tileH, target)
+    local wx, wy
+    if target then
+        wx, wy = target.x, target.y
+    else
+        local mx, my = love.mouse.getPosition()
 
-    -- convert mouse screen → camera space
-    local cx = mx - camera.x
-    local cy = my - camera.y
+        -- convert mouse screen → camera space
+        local cx = mx - camera.viewX - camera.x
+        local cy = my - camera.viewY - camera.y
 
-    -- convert camera space → world (iso)
-    local wx, wy = Iso.screenToWorld(cx, cy, tileW, tileH)
+        -- convert camera space → world (iso)
+        wx, wy = Iso.screenToWorld(cx, cy, tileW, tileH)
+    end
 
     local dx = wx - self.x
     local dy = wy - self.y
@@ -255,7 +237,7 @@ end
 -- INPUT (called from main)
 function Player:startDash(dx, dy)
     self.isDashing = true
-    self.dashTime = self.dashDuration
+    self.dashTime = self.archetype.dashDuration
     self.dashDX = dx
     self.dashDY = dy
 
@@ -274,7 +256,7 @@ function Player:update(dt, room, sounds, Audio)
     self.weapon:update(dt, sounds, Audio)
 
     -- Update animation frame (only advance when enough time has passed)
-    local a = self.anims[self.anim.name]
+    local a = self.archetype.anims[self.anim.name]
     if a and self.anim.playing then
         self.anim.timer = self.anim.timer + dt
         -- Only advance frame when timer exceeds speed threshold
@@ -346,7 +328,7 @@ function Player:update(dt, room, sounds, Audio)
 
     if self.isDashing then
         local step = 0.05
-        local remaining = self.dashSpeed * dt
+        local remaining = self.archetype.dashSpeed * dt
 
         while remaining > 0 do
             local s = math.min(step, remaining)
@@ -389,7 +371,8 @@ function Player:update(dt, room, sounds, Audio)
         self.facing.y = dy
     end
 
-    local speed = self.speed * dt
+    -- speedScale is set by slow/haste effects
+    local speed = self.archetype.speed * (self.speedScale or 1) * dt
     local tryX = self.x + dx * speed
     local tryY = self.y + dy * speed
 
@@ -435,13 +418,10 @@ function Player:drawWeapon(sx, sy)
     love.graphics.pop()
 end
 
-function Player:draw(iso, camera)
+function Player:draw(iso, queue)
+    -- World pixels; the render queue applies each view's camera
     local sx, sy = iso(self.x, self.y)
 
-    -- apply camera
-    sx = sx + camera.x
-    sy = sy + camera.y
-
     -- Determine which sprite set to use
     local spriteSet = "Idle"
     if self.anim.name == "walk" then
@@ -480,50 +460,60 @@ function Player:draw(iso, camera)
     -- Get the spritesheet and quad for this direction and frame
     local spritesheet = nil
     local quad = nil
+    local arch = self.archetype
+    local sprites, spritesheets = loadedSprites, loadedSpritesheets
 
-    if self.spritesheets[spriteSet] and self.spritesheets[spriteSet][spriteAngle] then
-        spritesheet = self.spritesheets[spriteSet][spriteAngle]
-        if self.sprites[spriteSet] and self.sprites[spriteSet][spriteAngle] then
-            local a = self.anims[self.anim.name]
+    if spritesheets[spriteSet] and spritesheets[spriteSet][spriteAngle] then
+        spritesheet = spritesheets[spriteSet][spriteAngle]
+        if sprites[spriteSet] and sprites[spriteSet][spriteAngle] then
+            local a = arch.anims[self.anim.name]
             local maxFrames = a and a.frames or 16
             local frameIndex = math.max(1, math.min(self.anim.frame, maxFrames))
-            quad = self.sprites[spriteSet][spriteAngle][frameIndex]
+            quad = sprites[spriteSet][spriteAngle][frameIndex]
         end
     end
 
     -- Fallback to Idle if sprite not found
-    if not spritesheet and self.spritesheets["Idle"] then
+    if not spritesheet and spritesheets["Idle"] then
         local fallbackAngle = spriteAngle or SPRITE_ANGLES[1]
-        spritesheet = self.spritesheets["Idle"][fallbackAngle]
-        if self.sprites["Idle"] and self.sprites["Idle"][fallbackAngle] then
-            local a = self.anims[self.anim.name]
+        spritesheet = spritesheets["Idle"][fallbackAngle]
+        if sprites["Idle"] and sprites["Idle"][fallbackAngle] then
+            local a = arch.anims[self.anim.name]
             local maxFrames = a and a.frames or 16
             local frameIndex = math.max(1, math.min(self.anim.frame, maxFrames))
-            quad = self.sprites["Idle"][fallbackAngle][frameIndex]
+            quad = sprites["Idle"][fallbackAngle][frameIndex]
         end
     end
 
+    if Quality.settings.shadows then
+        queue:setColor(0, 0, 0, 0.35)
+        queue:ellipse(RenderQueue.LAYER_DECALS, 1, "fill",
+            sx, sy + arch.shadowOffset, arch.shadowRadius, arch.shadowRadius * 0.4)
+    end
+
     if spritesheet and quad then
         -- Get frame dimensions from the quad
         local _, _, frameW, frameH = quad:getViewport()
 
         -- Draw sprite centered
-        love.graphics.draw(
+        queue:setColor(1, 1, 1, 1)
+        queue:sprite(
+            RenderQueue.LAYER_ENTITIES,
+            self.x + self.y,  -- iso draw order
             spritesheet,
             quad,
             sx,
             sy,
             0,
-            self.spriteScale,
-            self.spriteScale,
+            arch.spriteScale,
+            arch.spriteScale,
             frameW / 2,
             frameH / 2
         )
     else
         -- Fallback: draw a simple circle if sprites aren't loaded
-        love.graphics.setColor(1, 0, 0)
-        love.graphics.circle("fill", sx, sy, 10)
-        love.graphics.setColor(1, 1, 1)
+        queue:setColor(1, 0, 0, 1)
+        queue:circle(RenderQueue.LAYER_ENTITIES, self.x + self.y, "fill", sx, sy, 10)
     end
 end
 
@@ -531,8 +521,8 @@ function Player:usePrimary(enemies)
     return self.weapon:primary(enemies)
 end
 
-function Player:useSecondary(enemies)
-    return self.weapon:secondary(enemies)
+function Player:useSecondary(enemies, effects)
+    return self.weapon:secondary(enemies, effects)
 end
 
 return Player
@@ -5,68 +5,264 @@ local Room             = require("world.room")
 local Player           = require("entities.player")
 local Enemy            = require("entities.enemy")
 local VictoryText      = require("ui.victory_text")
+local RenderQueue      = require("core.render_queue")
+local DebugOverlay     = require("ui.debug_overlay")
+local Decals           = require("world.decals")
+local Loop             = require("core.loop")
+local Throttle         = require("core.throttle")
+local GC               = require("core.gc")
+local Capture          = require("core.capture")
+local Quality          = require("core.quality")
+local Floor            = require("world.floor")
+local Minimap          = require("ui.minimap")
+local HealthBars       = require("ui.health_bars")
+local Visibility       = require("world.visibility")
+local Effects          = require("core.effects")
+local Assets           = require("core.assets")
+local Memory           = require("core.memory")
+local SpatialHash      = require("world.spatial_hash")
+local Picking          = require("world.picking")
+local Archetypes       = require("core.archetypes")
+local Walls            = require("world.walls")
+local AnimClock        = require("core.anim_clock")
+local Director         = require("world.director")
+local Metrics          = require("core.metrics")
+local Hitch            = require("core.hitch")
+local ArchetypeCompiler = require("core.archetype_compiler")
 
 local TILE_W, TILE_H   = 150, 96
 
-local GRID_FILL        = { 84 / 255, 225 / 255, 227 / 255 }
-local GRID_LINE        = { 84 / 255, 225 / 255, 227 / 255 }
-
 local victoryTriggered = false
 
+local PILLARS = 6
+
+-- Hitch detector scopes and counters (see core/hitch.lua)
+local HITCH_ENEMIES   = Hitch.scope("enemies")
+local HITCH_FLUSH     = Hitch.scope("flush")
+local HITCH_N_ENEMIES = Hitch.counter("enemies")
+local HITCH_N_EFFECTS = Hitch.counter("effects")
+local HITCH_N_CAPTURE = Hitch.counter("captureInFlight")
+local HITCH_N_ASSETS  = Hitch.counter("assetReads")
+
+-- Reused flat array of sprite rects for occlusion (left, top, right, bottom, depth)
+local occluded = {}
+
+-- Frame pacing + late input sampling (see core/loop.lua)
+love.run = Loop.run
+
+local function isoProject(x, y)
+    return Iso.project(x, y, TILE_W, TILE_H)
+end
+
+-- Append entity e's sprite rect as the (n + 1)th occluded rect
+local function addOccluded(n, e)
+    local l, t, r, b = Picking.spriteRect(e.archetype)
+    local sx, sy = isoProject(e.x, e.y)
+    local o = n * 5
+    occluded[o + 1], occluded[o + 2] = sx + l, sy + t
+    occluded[o + 3], occluded[o + 4] = sx + r, sy + b
+    occluded[o + 5] = e.x + e.y
+    return n + 1
+end
+
 -- =========================
--- ROOM DRAW
+-- VIEWS
 -- =========================
-local function drawRoom()
-    for y = 1, room.h do
-        for x = 1, room.w do
-            if room.map[y][x] then
-                local sx, sy = Iso.project(x - 1, y - 1, TILE_W, TILE_H)
-
-                local p1x, p1y = camera.x + sx, camera.y + sy
-                local p2x, p2y = camera.x + sx + TILE_W / 2, camera.y + sy + TILE_H / 2
-                local p3x, p3y = camera.x + sx, camera.y + sy + TILE_H
-                local p4x, p4y = camera.x + sx - TILE_W / 2, camera.y + sy + TILE_H / 2
-
-                local depth = y / room.h
-
-                love.graphics.setColor(
-                    GRID_FILL[1],
-                    GRID_FILL[2],
-                    GRID_FILL[3],
-                    0.08 + depth * 0.10
-                )
-                love.graphics.polygon("fill", p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y)
-
-                love.graphics.setColor(GRID_LINE[1], GRID_LINE[2], GRID_LINE[3], 0.35)
-                love.graphics.polygon("line", p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y)
-            end
-        end
+-- Every camera in `cameras` gets its own viewport; the render queue sorts
+-- the frame's commands once and replays them per view.
+local function setSplitScreen(on)
+    local sw, sh = love.graphics.getWidth(), love.graphics.getHeight()
+    splitScreen = on
+
+    if on then
+        camera:setViewport(0, 0, sw / 2, sh)
+        camera2:setViewport(sw / 2, 0, sw / 2, sh)
+        cameras = { camera, camera2 }
+    else
+        camera:setViewport(0, 0, sw, sh)
+        cameras = { camera }
     end
+end
 
-    love.graphics.setColor(1, 1, 1, 1)
+-- Until co-op has a second player, the second view tracks the nearest enemy
+local function secondViewTarget()
+    local best, bestDist = player, math.huge
+    for _, e in ipairs(enemies) do
+        local dx, dy = e.x - player.x, e.y - player.y
+        local d = dx * dx + dy * dy
+        if not e.dead and d < bestDist then
+            best, bestDist = e, d
+        end
+    end
+    return best
 end
 
 -- =========================
 -- LOAD
 -- =========================
-function love.load()
+function love.load(args)
+    if args and args[1] == "--bench" then
+        local status = require("bench").run(args[2], args)
+        love.event.quit(status or 0)
+        return
+    end
+
+    -- One open archive for every asset read (loose files if not packed)
+    Memory.configure(args)
+    Assets.open(args)
+    Quality.init(args)
+
     sounds = Audio.load()
 
+    -- Specialised Enemy:update with archetype constants folded in
+    ArchetypeCompiler.configure(args)
+    if ArchetypeCompiler.enabled then
+        ArchetypeCompiler.install(Enemy, Archetypes.enemy)
+    end
+
     room = Room.new(25, 25)
     room:generate()
+    floor = Floor.new(room, TILE_W, TILE_H, Quality.settings.floorMode)
+    minimap = Minimap.new(room)
+    healthBars = HealthBars.new(TILE_W, TILE_H, Archetypes.enemy)
+    visibility = Visibility.new(room)
+    floor:setVisibility(visibility)
+
+    -- Pillars as props; the tile changes reach floor, fog and minimap
+    for _ = 1, PILLARS do
+        local x, y = room:getRandomTile()
+        room:setWalkable(math.floor(x) + 1, math.floor(y) + 1, false)
+    end
+    walls = Walls.new(room, TILE_W, TILE_H, visibility)
 
     player  = Player.new(room:getRandomTile())
-    enemy   = Enemy.new(room:getRandomTile())
+    enemies = {}
+    enemyIndex = SpatialHash.new(2)
+    hovered = nil
+
+    -- Waves, paced to the enemy frame budget (see world/director.lua).
+    -- The first spawns land mid-frame, so their sprites load here (and
+    -- are part of the recorded asset order)
+    Enemy.preload()
+    director = Director.new(room, function(x, y)
+        local e = Enemy.new(x, y)
+        enemies[#enemies + 1] = e
+        enemyIndex:insert(e, x, y)
+    end)
 
     camera  = Camera.new(960, 200)
+    camera2 = Camera.new(960, 200)
+    setSplitScreen(false)
     victory = VictoryText.new()
+
+    renderQueue  = RenderQueue.new()
+    debugOverlay = DebugOverlay.new()
+    decals       = Decals.new()
+    capture      = Capture.new()
+    effects      = Effects.new()
+
+    Metrics.configure(args)
+    Metrics.defineDefaults({ enemies = enemies, effects = effects })
+
+    Assets.saveOrder()
 end
 
 -- =========================
 -- UPDATE
 -- =========================
+-- Cameras, hover and aim, wall fades, minimap and health bars
+local function updateView(dt)
+    -- CAMERA FOLLOW
+    camera:update(
+        player.x,
+        player.y,
+        function(x, y) return Iso.project(x, y, TILE_W, TILE_H) end,
+        TILE_H,
+        dt
+    )
+
+    if splitScreen then
+        local target = secondViewTarget()
+        camera2:update(target.x, target.y, isoProject, TILE_H, dt)
+    end
+
+    -- Hover / lock-on: cursor to world pixels in the player's view
+    local mx, my = love.mouse.getPosition()
+    hovered = Picking.pick(enemyIndex, Archetypes.enemy,
+        mx - camera.viewX - camera.x, my - camera.viewY - camera.y, TILE_W, TILE_H)
+    if hovered and not visibility:canSee(hovered.x, hovered.y) then hovered = nil end
+
+    player:updateAim(camera, TILE_W, TILE_H, hovered)
+
+    -- Fade walls standing in front of the player or visible enemies
+    local n = addOccluded(0, player)
+    for _, e in ipairs(enemies) do
+        if not e.deathAnimComplete and visibility:canSee(e.x, e.y) then
+            n = addOccluded(n, e)
+        end
+    end
+    walls:update(dt, occluded, n)
+    minimap:update()
+    healthBars:update(enemies, visibility)
+end
+
+-- Clocks only: the loop runs this in substeps of at most
+-- Throttle.config.maxStep, so long throttled frames keep step sizes
+function love.tick(dt)
+    -- Shared clocks for every looping animation clip
+    AnimClock.update(dt)
+
+    -- Status effects tick at a fixed rate; one death sound per batch,
+    -- none for the damage ticks themselves
+    local _, kills = effects:update(dt)
+    if kills > 0 then
+        Audio.play(sounds.death)
+    end
+
+    Audio.update(dt)
+end
+
+-- Once per frame with the frame's whole dt, so a throttled frame costs
+-- one simulation pass however long it was
 function love.update(dt)
-    enemy:update(dt, player)
+    -- Only recomputes when the player enters a new tile or walls change
+    visibility:update(player.x, player.y)
+
+    director:update(dt, player, #enemies)
+
+    Hitch.begin(HITCH_ENEMIES)
+    local simStart = love.timer.getTime()
+    local simCount = #enemies
+    local lod2 = director.lodDistance * director.lodDistance
+    for i = #enemies, 1, -1 do
+        local e = enemies[i]
+        -- Line of sight is symmetric: enemies the player can't see can't
+        -- see the player either, so they skip tracking them; so do
+        -- enemies past the director's LOD distance
+        local dx, dy = e.x - player.x, e.y - player.y
+        local aware = dx * dx + dy * dy <= lod2 and visibility:canSee(e.x, e.y)
+        e:update(dt, aware and player or nil)
+        enemyIndex:update(e, e.x, e.y)
+
+        -- Bake finished corpses into the decal layer and free the entity
+        if e.deathAnimComplete then
+            decals:stampEnemy(e, isoProject)
+            enemyIndex:remove(e)
+            enemies[i] = enemies[#enemies]
+            enemies[#enemies] = nil
+        end
+    end
+
+    director:recordSim((love.timer.getTime() - simStart) * 1000, simCount)
+    Hitch.finish(HITCH_ENEMIES)
+
+    if director:isFinished() and #enemies == 0 and not victoryTriggered then
+        victoryTriggered = true
+        victory.show = true
+        Audio.play(sounds.victory)
+        GC.breakpoint("victory")
+    end
+
     victory:update(dt)
 
     -- PLAYER (movement + dash + weapon update)
@@ -74,36 +270,82 @@ function love.update(dt)
 
     -- WEAPON INPUT (sounds delayed to 50% of animation duration)
     if love.mouse.isDown(1) then
-        if player:usePrimary({ enemy }) then
+        if player:usePrimary(enemies) then
             Audio.playDelayed(sounds.attack_swipe, 1.0)  -- 50% of 2.0s animation
         end
     end
 
     if love.mouse.isDown(2) then
-        if player:useSecondary({ enemy }) then
+        if player:useSecondary(enemies, effects) then
             Audio.playDelayed(sounds.attack_jump, 1.2)  -- 50% of 2.4s animation
         end
     end
 
-    -- CAMERA FOLLOW
-    camera:update(
-        player.x,
-        player.y,
-        function(x, y) return Iso.project(x, y, TILE_W, TILE_H) end,
-        TILE_H,
-        dt
-    )
+    -- Presentation only; nothing to keep up while minimized
+    if Throttle.shouldDraw() then
+        updateView(dt)
+    end
 
-    player:updateAim(camera, TILE_W, TILE_H)
+    Memory.update()
+    Metrics.update(dt)
 
+    Hitch.set(HITCH_N_ENEMIES, #enemies)
+    Hitch.set(HITCH_N_EFFECTS, effects.count)
+    Hitch.set(HITCH_N_CAPTURE, capture:inFlight())
+    Hitch.set(HITCH_N_ASSETS, Assets.stats.packed + Assets.stats.loose)
+end
 
-    Audio.update(dt)
+-- =========================
+-- FOCUS / VISIBILITY
+-- =========================
+function love.focus(focused)
+    Throttle.setFocused(focused)
+end
+
+function love.visible(visible)
+    Throttle.setVisible(visible)
 end
 
 -- =========================
--- DASH INPUT
+-- INPUT
 -- =========================
+function love.mousepressed(x, y, button)
+    Hitch.input("mouse", button)
+end
+
 function love.keypressed(key)
+    Hitch.input("key", key)
+
+    if key == "f10" then
+        Hitch.dump("manual (F10)")
+        return
+    end
+
+    if key == "f3" then
+        debugOverlay:toggle()
+        return
+    end
+
+    if key == "f2" then
+        setSplitScreen(not splitScreen)
+        return
+    end
+
+    if key == "m" then
+        minimap:toggle()
+        return
+    end
+
+    if key == "f4" then
+        Memory.dump()
+        return
+    end
+
+    if key == "f9" then
+        capture:toggle()
+        return
+    end
+
     if key == "space" and not player.isDashing then
         -- Isometric screen-space directions for dash
         local dx, dy = 0, 0
@@ -126,18 +368,49 @@ end
 -- DRAW
 -- =========================
 function love.draw()
-    drawRoom()
+    renderQueue:begin()
 
-    local drawables = { player, enemy }
-    table.sort(drawables, function(a, b)
-        return a.y < b.y
-    end)
+    floor:draw(renderQueue)
+    decals:draw(renderQueue)
+    walls:draw(renderQueue)
+
+    -- Entities and walls are depth-sorted by the queue (depth = x + y)
+    player:draw(isoProject, renderQueue)
 
-    for _, e in ipairs(drawables) do
-        e:draw(function(x, y)
-            return Iso.project(x, y, TILE_W, TILE_H)
-        end, camera)
+    local drawStart = love.timer.getTime()
+    local drawn = 0
+    local imp2 = director.impostorDistance * director.impostorDistance
+    for _, e in ipairs(enemies) do
+        if visibility:canSee(e.x, e.y) then
+            local dx, dy = e.x - player.x, e.y - player.y
+            e:draw(isoProject, renderQueue, e == hovered, dx * dx + dy * dy > imp2)
+            drawn = drawn + 1
+        end
+    end
+    healthBars:draw(renderQueue)
+    local submitMs = (love.timer.getTime() - drawStart) * 1000
+
+    -- Enemies are most of the queue at scale, so charge them the flush
+    Hitch.begin(HITCH_FLUSH)
+    local flushStart = love.timer.getTime()
+    renderQueue:flush(cameras)
+    director:recordRender(submitMs + (love.timer.getTime() - flushStart) * 1000, drawn)
+    Hitch.finish(HITCH_FLUSH)
+
+    if splitScreen then
+        love.graphics.setColor(0, 0, 0, 1)
+        love.graphics.rectangle("fill", camera2.viewX - 1, 0, 2, love.graphics.getHeight())
+        love.graphics.setColor(1, 1, 1, 1)
     end
 
+    minimap:draw(player, enemies, TILE_W, TILE_H, visibility)
     victory:draw()
+    debugOverlay:draw(renderQueue, capture)
+    capture:captureFrame()
+end
+
+-- Every frame, including undrawn ones while the window is hidden, so
+-- exports keep going in the background
+function love.endframe(drawn)
+    Metrics.flush(drawn)
 end
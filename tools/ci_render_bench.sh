@@ -0,0 +1,29 @@
+#!/bin/sh
+# Run the render regression benchmark on a machine without a GPU:
+# Mesa's llvmpipe software rasterizer inside a virtual X server.
+# Exits non-zero when bench/render.lua reports a regression.
+#   tools/ci_render_bench.sh [enemies] [frames] [--record]
+#
+# The job stays disabled (exits 0 with a notice) until a baseline
+# recorded on the CI image is committed as bench/render_baseline.txt:
+#   tools/ci_render_bench.sh --record
+set -e
+cd "$(dirname "$0")/.."
+
+BASELINE=bench/render_baseline.txt
+
+record=0
+for a in "$@"; do
+    [ "$a" = "--record" ] && record=1
+done
+
+if [ "$record" = 0 ] && [ ! -f "$BASELINE" ]; then
+    echo "render bench disabled: no $BASELINE; record one with --record on the CI image"
+    exit 0
+fi
+
+export LIBGL_ALWAYS_SOFTWARE=1
+export GALLIUM_DRIVER=llvmpipe
+export SDL_AUDIODRIVER=dummy
+
+exec xvfb-run -a -s "-screen 0 1920x1080x24" love . --bench render --ci "$@"
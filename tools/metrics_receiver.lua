@@ -0,0 +1,83 @@
+-- Stand-in receiver for checking core/metrics.lua output locally.
+-- Needs LuaSocket for UDP (bundled with LÖVE; `luarocks install
+-- luasocket` for plain Lua). Exits non-zero on malformed input.
+--   lua tools/metrics_receiver.lua udp [port] [packets]
+--       listen for StatsD datagrams (default 8125, stop after 3 packets)
+--   lua tools/metrics_receiver.lua file <path>
+--       validate a Prometheus textfile
+local mode = arg[1] or "udp"
+
+local function checkStatsd(text)
+    local bad, n = 0, 0
+    for line in text:gmatch("[^\n]+") do
+        n = n + 1
+        local name, value, kind = line:match("^([%w_%.]+):([%-%d%.e+]+)|(%a+)$")
+        if not name or not tonumber(value) or (kind ~= "g" and kind ~= "c" and kind ~= "ms") then
+            print("  malformed: " .. line)
+            bad = bad + 1
+        else
+            print(string.format("  %-40s %s (%s)", name, value, kind))
+        end
+    end
+    return n, bad
+end
+
+local function checkPrometheus(text)
+    local bad, n = 0, 0
+    local typed = {}
+    for line in text:gmatch("[^\n]+") do
+        local typeName = line:match("^# TYPE ([%w_:]+) %a+$")
+        if typeName then
+            typed[typeName] = true
+        elseif not line:match("^# HELP ") then
+            n = n + 1
+            local name, labelSet, value = line:match("^([%a_:][%w_:]*)(%b{}) (%S+)$")
+            if not name then
+                name, value = line:match("^([%a_:][%w_:]*) (%S+)$")
+            end
+            if not name or not tonumber(value) then
+                print("  malformed: " .. line)
+                bad = bad + 1
+            elseif not typed[name] then
+                print("  sample before its # TYPE: " .. line)
+                bad = bad + 1
+            else
+                print(string.format("  %-50s %s", name .. (labelSet or ""), value))
+            end
+        end
+    end
+    return n, bad
+end
+
+local total, failures = 0, 0
+
+if mode == "file" then
+    local f = assert(io.open(assert(arg[2], "usage: metrics_receiver.lua file <path>"), "r"))
+    local n, bad = checkPrometheus(f:read("*a"))
+    f:close()
+    total, failures = n, bad
+else
+    local socket = require("socket")
+    local port = tonumber(arg[2]) or 8125
+    local packets = tonumber(arg[3]) or 3
+
+    local udp = assert(socket.udp())
+    assert(udp:setsockname("127.0.0.1", port))
+    print(string.format("listening on udp 127.0.0.1:%d for %d packets", port, packets))
+
+    for i = 1, packets do
+        local data, err = udp:receive()
+        if not data then
+            print(string.format("packet %d: receive failed: %s", i, tostring(err)))
+            failures = failures + 1
+            break
+        end
+        print(string.format("packet %d (%d bytes)", i, #data))
+        local n, bad = checkStatsd(data)
+        total, failures = total + n, failures + bad
+    end
+    udp:close()
+end
+
+print(string.format("%d samples, %d malformed", total, failures))
+os.exit(failures == 0 and total > 0 and 0 or 1)
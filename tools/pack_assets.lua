@@ -0,0 +1,88 @@
+-- Build step: pack assets/ into assets.pak (see core/assets.lua).
+-- Run from the game directory with plain Lua or LuaJIT:
+--   luajit tools/pack_assets.lua [order file] [output]
+-- Files listed in the order file (default tools/asset_order.txt, from
+-- `love . --record-asset-order`) come first, in that order, so startup
+-- reads the archive sequentially; everything else follows sorted by path.
+-- Lines starting with # in the order file are comments.
+local orderPath = arg[1] or "tools/asset_order.txt"
+local outPath = arg[2] or "assets.pak"
+
+local MAGIC = "LPAK1"
+local CHUNK = 1024 * 1024
+
+local function listFiles(dir)
+    local cmd
+    if package.config:sub(1, 1) == "\\" then
+        cmd = 'dir /b /s /a-d "' .. dir .. '"'
+    else
+        cmd = 'find "' .. dir .. '" -type f'
+    end
+
+    local files = {}
+    local p = assert(io.popen(cmd))
+    for line in p:lines() do
+        -- Relative, forward slashes: the same strings the game requests
+        local path = line:gsub("\\", "/"):gsub("^.-(" .. dir .. "/)", "%1")
+        if not path:match("/%.") then table.insert(files, path) end
+    end
+    p:close()
+    table.sort(files)
+    return files
+end
+
+local function fileSize(path)
+    local f = assert(io.open(path, "rb"))
+    local size = f:seek("end")
+    f:close()
+    return size
+end
+
+local all = listFiles("assets")
+local exists = {}
+for _, path in ipairs(all) do exists[path] = true end
+
+-- Recorded load order first, then the rest
+local entries, placed = {}, {}
+local f = io.open(orderPath, "r")
+if f then
+    for line in f:lines() do
+        if line:sub(1, 1) ~= "#" and exists[line] and not placed[line] then
+            placed[line] = true
+            table.insert(entries, line)
+        end
+    end
+    f:close()
+else
+    print("no " .. orderPath .. "; packing in path order")
+end
+local ordered = #entries
+for _, path in ipairs(all) do
+    if not placed[path] then table.insert(entries, path) end
+end
+
+-- Index with offsets relative to the end of the header
+local index, offset = { MAGIC }, 0
+local sizes = {}
+for i, path in ipairs(entries) do
+    sizes[i] = fileSize(path)
+    table.insert(index, string.format("%s\t%d\t%d", path, offset, sizes[i]))
+    offset = offset + sizes[i]
+end
+
+local out = assert(io.open(outPath, "wb"))
+out:write(table.concat(index, "\n"), "\n\n")
+
+for _, path in ipairs(entries) do
+    local src = assert(io.open(path, "rb"))
+    while true do
+        local chunk = src:read(CHUNK)
+        if not chunk then break end
+        out:write(chunk)
+    end
+    src:close()
+end
+out:close()
+
+print(string.format("%s: %d files (%d in load order), %.1f MB",
+    outPath, #entries, ordered, offset / (1024 * 1024)))
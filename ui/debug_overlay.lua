@@ -0,0 +1,76 @@
+local Loop = require("core.loop")
+local GC = require("core.gc")
+local Memory = require("core.memory")
+
+local DebugOverlay = {}
+DebugOverlay.__index = DebugOverlay
+
+function DebugOverlay.new()
+    local self = setmetatable({}, DebugOverlay)
+
+    self.show = false
+    self.font = love.graphics.newFont(14)
+    self.lines = {}
+
+    return self
+end
+
+function DebugOverlay:toggle()
+    self.show = not self.show
+end
+
+function DebugOverlay:draw(queue, capture)
+    if not self.show then return end
+
+    -- Read before drawing the overlay itself so its text isn't counted
+    local gs = love.graphics.getStats()
+    local qs = queue.stats
+
+    local lines = self.lines
+    local n = 0
+    local function add(fmt, ...)
+        n = n + 1
+        lines[n] = string.format(fmt, ...)
+    end
+
+    local ls = Loop.getStats()
+    add("FPS %d  cap %s%s", love.timer.getFPS(),
+        Loop.config.fpsCap > 0 and tostring(Loop.config.fpsCap) or "off",
+        Loop.config.lowLatency and "  low-latency" or "")
+    add("frame %.2f ms  stddev %.3f ms  worst %.2f ms",
+        ls.mean * 1000, ls.stddev * 1000, ls.worst * 1000)
+    add("draw calls %d (batched %d)", gs.drawcalls, gs.drawcallsbatched)
+    add("texture mem %.1f MB  images %d  canvases %d",
+        gs.texturememory / (1024 * 1024), gs.images, gs.canvases)
+    add("lua heap %.1f MB  gc %s  %d steps x %d  (%.3f ms/step)",
+        collectgarbage("count") / 1024, GC.profileName or "-", GC.stats.steps,
+        GC.stepSize, GC.stepCost * 1000)
+    local mt, mb = Memory.totals, Memory.budgets
+    add("tracked: tex %.0f/%.0f MB  canvas %.0f/%.0f MB  audio %.1f/%.0f MB  mesh %.1f MB",
+        mt.textures / 1048576, mb.textures / 1048576, mt.canvases / 1048576,
+        mb.canvases / 1048576, mt.audio / 1048576, mb.audio / 1048576, mt.meshes / 1048576)
+    add("queue: %d cmds, %d views -> %d runs, %d culled",
+        qs.commands, qs.views, qs.runs, qs.culled)
+    add("state changes: color %d  texture %d  shader %d  blend %d",
+        qs.colorChanges, qs.textureChanges, qs.shaderChanges, qs.blendChanges)
+
+    if capture and capture.recording then
+        add("REC frame %d  in flight %d/%d  dropped %d",
+            capture.frame, capture:inFlight(), capture.ring, capture.dropped)
+    end
+
+    for i = #lines, n + 1, -1 do lines[i] = nil end
+
+    love.graphics.setFont(self.font)
+    local lh = self.font:getHeight()
+
+    love.graphics.setColor(0, 0, 0, 0.6)
+    love.graphics.rectangle("fill", 8, 8, 420, n * lh + 12)
+
+    love.graphics.setColor(1, 1, 1, 1)
+    for i = 1, n do
+        love.graphics.print(lines[i], 14, 8 + 6 + (i - 1) * lh)
+    end
+end
+
+return DebugOverlay
@@ -0,0 +1,168 @@
+-- Overhead health bars for every visible, damaged enemy in one draw.
+-- Each bar owns a slot of 12 vertices (background + fill quads) in one
+-- dynamic mesh, in iso world pixels so camera movement never touches it.
+-- A slot is rewritten only when its enemy's position or hp changed;
+-- enemies at full health, dead or out of sight give up their slot
+-- (swap-remove keeps the slots packed, so the draw range stays tight).
+local Iso = require("core.iso")
+local RenderQueue = require("core.render_queue")
+local Memory = require("core.memory")
+
+local HealthBars = {}
+HealthBars.__index = HealthBars
+
+local VERTS = 12            -- per bar
+local BACK = { 0.08, 0.08, 0.08, 0.85 }
+
+function HealthBars.new(tileW, tileH, archetype, capacity)
+    local self = setmetatable({}, HealthBars)
+
+    self.tileW = tileW
+    self.tileH = tileH
+    self.archetype = archetype
+
+    self.count = 0
+    self.owner = {}                                   -- slot -> enemy
+    self.slotOf = setmetatable({}, { __mode = "k" })  -- enemy -> slot
+    self.seen = {}                                    -- slot -> frame stamp
+    self.frame = 0
+
+    -- What each slot's vertices were last written from
+    self.sx, self.sy, self.frac = {}, {}, {}
+
+    self.stats = { bars = 0, rewritten = 0 }
+
+    self:allocate(capacity or 128)
+
+    return self
+end
+
+function HealthBars:allocate(capacity)
+    self.capacity = capacity
+    if self.mesh then Memory.untrack(self.mesh); self.mesh:release() end
+    self.mesh = love.graphics.newMesh(capacity * VERTS, "triangles", "dynamic")
+    Memory.trackMesh("health bars", self.mesh)
+    -- Fresh mesh: every live slot has to be written again
+    for s = 1, self.count do self.frac[s] = -1 end
+end
+
+local function writeQuad(mesh, v, x0, y0, x1, y1, r, g, b, a)
+    mesh:setVertex(v,     x0, y0, 0, 0, r, g, b, a)
+    mesh:setVertex(v + 1, x1, y0, 0, 0, r, g, b, a)
+    mesh:setVertex(v + 2, x1, y1, 0, 0, r, g, b, a)
+    mesh:setVertex(v + 3, x0, y0, 0, 0, r, g, b, a)
+    mesh:setVertex(v + 4, x1, y1, 0, 0, r, g, b, a)
+    mesh:setVertex(v + 5, x0, y1, 0, 0, r, g, b, a)
+end
+
+function HealthBars:write(s, sx, sy, frac)
+    local bar = self.archetype.healthBar
+    local hw, h = bar.width / 2, bar.height
+    local x0, y0 = sx - hw, sy - bar.offset
+    local v = (s - 1) * VERTS + 1
+
+    writeQuad(self.mesh, v, x0 - 1, y0 - 1, x0 + bar.width + 1, y0 + h + 1,
+        BACK[1], BACK[2], BACK[3], BACK[4])
+    -- Green at full health through yellow to red
+    local r = frac > 0.5 and (1 - frac) * 2 or 1
+    local g = frac > 0.5 and 1 or frac * 2
+    writeQuad(self.mesh, v + 6, x0, y0, x0 + bar.width * frac, y0 + h, r, g, 0.15, 1)
+
+    self.sx[s], self.sy[s], self.frac[s] = sx, sy, frac
+    self.stats.rewritten = self.stats.rewritten + 1
+end
+
+-- Move the last slot into `s`
+function HealthBars:release(s)
+    local n = self.count
+    self.slotOf[self.owner[s]] = nil
+
+    if s ~= n then
+        local moved = self.owner[n]
+        self.owner[s] = moved
+        self.slotOf[moved] = s
+        self.seen[s] = self.seen[n]
+        self.frac[s] = -1  -- vertices still belong to the old slot
+    end
+
+    self.owner[n] = nil
+    self.count = n - 1
+end
+
+function HealthBars:update(enemies, visibility)
+    local frame = self.frame + 1
+    self.frame = frame
+    self.stats.rewritten = 0
+
+    local maxHp = self.archetype.maxHp
+    local hw, hh = self.tileW, self.tileH
+
+    for i = 1, #enemies do
+        local e = enemies[i]
+        if not e.dead and e.hp < maxHp and visibility:canSee(e.x, e.y) then
+            local s = self.slotOf[e]
+            if not s then
+                if self.count == self.capacity then
+                    self:allocate(self.capacity * 2)
+                end
+                s = self.count + 1
+                self.count = s
+                self.owner[s] = e
+                self.slotOf[e] = s
+                self.frac[s] = -1
+            end
+            self.seen[s] = frame
+
+            local sx, sy = Iso.project(e.x, e.y, hw, hh)
+            local frac = e.hp / maxHp
+            if frac < 0 then frac = 0 end
+            if sx ~= self.sx[s] or sy ~= self.sy[s] or frac ~= self.frac[s] then
+                self:write(s, sx, sy, frac)
+            end
+        end
+    end
+
+    -- Anything not refreshed above is healed, dead, hidden or gone
+    for s = self.count, 1, -1 do
+        if self.seen[s] ~= frame then self:release(s) end
+    end
+
+    -- Slots moved by release() carry stale vertices
+    for s = 1, self.count do
+        if self.frac[s] < 0 then
+            local e = self.owner[s]
+            local frac = e.hp / maxHp
+            local sx, sy = Iso.project(e.x, e.y, hw, hh)
+            self:write(s, sx, sy, frac < 0 and 0 or frac)
+        end
+    end
+
+    self.stats.bars = self.count
+end
+
+-- One mesh command; the queue culls it per view by the bars' bounds.
+-- Overlay layer on purpose: bars are UI and draw over wall blocks, so a
+-- damaged enemy behind a (faded) wall still shows its bar. Depth-sorting
+-- each bar with the entities would take one command per bar.
+function HealthBars:draw(queue)
+    local n = self.count
+    if n == 0 then return end
+
+    local bar = self.archetype.healthBar
+    local x0, y0, x1, y1 = math.huge, math.huge, -math.huge, -math.huge
+    local sx, sy = self.sx, self.sy
+    for s = 1, n do
+        if sx[s] < x0 then x0 = sx[s] end
+        if sx[s] > x1 then x1 = sx[s] end
+        if sy[s] < y0 then y0 = sy[s] end
+        if sy[s] > y1 then y1 = sy[s] end
+    end
+
+    self.mesh:setDrawRange(1, n * VERTS)
+    queue:setColor(1, 1, 1, 1)
+    queue:mesh(RenderQueue.LAYER_OVERLAY, 0, self.mesh, 0, 0,
+        x0 - bar.width / 2 - 1, y0 - bar.offset - 1,
+        x1 + bar.width / 2 + 1, y1 - bar.offset + bar.height + 1)
+end
+
+return HealthBars
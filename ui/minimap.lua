@@ -0,0 +1,143 @@
+-- Minimap drawn from Room.map, one pixel per tile.
+-- The image is built once; tile changes are patched in with
+-- Image:replacePixels over the dirty region only. Entities are a single
+-- colored love.graphics.points call from pooled point tables, so the
+-- per-frame cost is one image draw plus one points draw at any map size.
+local ffi = require("ffi")
+local Memory = require("core.memory")
+
+local Minimap = {}
+Minimap.__index = Minimap
+
+local FLOOR_COLOR  = { 84, 225, 227, 150 }
+local WALL_COLOR   = { 10, 20, 24, 110 }
+local PLAYER_COLOR = { 1, 0.94, 0.07, 1 }
+local ENEMY_COLOR  = { 1, 0.25, 0.2, 1 }
+
+-- Above this fraction of the map, re-upload everything instead of a region
+local FULL_UPLOAD_RATIO = 0.25
+
+function Minimap.new(room, size)
+    local self = setmetatable({}, Minimap)
+
+    self.room = room
+    self.size = size or 220  -- on-screen diamond width in pixels
+    self.show = true
+
+    self.data = love.image.newImageData(room.w, room.h)
+    self.pixels = ffi.cast("uint8_t*", self.data:getFFIPointer())
+    for y = 1, room.h do
+        for x = 1, room.w do
+            self:writeTile(x, y)
+        end
+    end
+
+    self.image = love.graphics.newImage(self.data)
+    Memory.trackTexture("minimap", self.image)
+    self.image:setFilter("nearest", "nearest")
+
+    -- Dirty region in tile coords, nil when clean
+    self.dirtyX0, self.dirtyY0, self.dirtyX1, self.dirtyY1 = nil, nil, nil, nil
+    room:onChange(function(x, y) self:markDirty(x, y) end)
+
+    self.points = {}      -- argument to love.graphics.points
+    self.pointPool = {}   -- reused { x, y, r, g, b, a } tables
+
+    return self
+end
+
+function Minimap:writeTile(x, y)
+    local c = self.room.map[y][x] and FLOOR_COLOR or WALL_COLOR
+    local i = ((y - 1) * self.room.w + (x - 1)) * 4
+    local p = self.pixels
+    p[i], p[i + 1], p[i + 2], p[i + 3] = c[1], c[2], c[3], c[4]
+end
+
+function Minimap:markDirty(x, y)
+    self:writeTile(x, y)
+    if not self.dirtyX0 then
+        self.dirtyX0, self.dirtyY0, self.dirtyX1, self.dirtyY1 = x, y, x, y
+    else
+        self.dirtyX0 = math.min(self.dirtyX0, x)
+        self.dirtyY0 = math.min(self.dirtyY0, y)
+        self.dirtyX1 = math.max(self.dirtyX1, x)
+        self.dirtyY1 = math.max(self.dirtyY1, y)
+    end
+end
+
+-- Upload pending tile changes
+function Minimap:update()
+    if not self.dirtyX0 then return end
+
+    local x0, y0 = self.dirtyX0 - 1, self.dirtyY0 - 1
+    local w, h = self.dirtyX1 - x0, self.dirtyY1 - y0
+
+    if w * h > self.room.w * self.room.h * FULL_UPLOAD_RATIO then
+        self.image:replacePixels(self.data)
+    else
+        local region = love.image.newImageData(w, h)
+        region:paste(self.data, 0, 0, x0, y0, w, h)
+        self.image:replacePixels(region, nil, nil, x0, y0)
+        region:release()
+    end
+
+    self.dirtyX0, self.dirtyY0, self.dirtyX1, self.dirtyY1 = nil, nil, nil, nil
+end
+
+function Minimap:toggle()
+    self.show = not self.show
+end
+
+function Minimap:addPoint(n, x, y, color)
+    local pt = self.pointPool[n]
+    if not pt then
+        pt = {}
+        self.pointPool[n] = pt
+    end
+    pt[1], pt[2] = x, y
+    pt[3], pt[4], pt[5], pt[6] = color[1], color[2], color[3], color[4]
+    self.points[n] = pt
+end
+
+-- Enemies outside `visibility` (optional) are left off, as in the main view
+function Minimap:draw(player, enemies, tileW, tileH, visibility)
+    if not self.show then return end
+
+    local room = self.room
+    local sw = love.graphics.getWidth()
+    local margin = 16
+
+    -- Rotate 45 degrees and flatten so the map lines up with the iso view
+    local scale = self.size / ((room.w + room.h) / math.sqrt(2))
+    local cx = sw - margin - self.size / 2
+    local cy = margin + self.size * (tileH / tileW) / 2
+
+    local n = 0
+    for _, e in ipairs(enemies) do
+        if not e.dead and (not visibility or visibility:canSee(e.x, e.y)) then
+            n = n + 1
+            self:addPoint(n, e.x, e.y, ENEMY_COLOR)
+        end
+    end
+    n = n + 1
+    self:addPoint(n, player.x, player.y, PLAYER_COLOR)
+    for i = #self.points, n + 1, -1 do self.points[i] = nil end
+
+    love.graphics.push()
+    love.graphics.translate(cx, cy)
+    love.graphics.scale(1, tileH / tileW)
+    love.graphics.rotate(math.pi / 4)
+    love.graphics.scale(scale)
+    love.graphics.translate(-room.w / 2, -room.h / 2)
+
+    love.graphics.setColor(1, 1, 1, 1)
+    love.graphics.draw(self.image, 0, 0)
+
+    love.graphics.setPointSize(4)
+    love.graphics.points(self.points)
+
+    love.graphics.pop()
+    love.graphics.setColor(1, 1, 1, 1)
+end
+
+return Minimap
@@ -1,4 +1,5 @@
 local Weapon = require("weapons.base_weapon")
+local Archetypes = require("core.archetypes")
 
 local Mace = setmetatable({}, Weapon)
 Mace.__index = Mace
@@ -6,14 +7,15 @@ Mace.__index = Mace
 function Mace:new(owner)
     local w       = Weapon.new(self, owner)
 
-    w.sweepRange  = 1.5  -- reduced from 3 for closer combat
-    w.sweepDamage = 1    -- reduced from 20
-    w.slamRadius  = 2    -- reduced from 4 for closer combat
-    w.slamDamage  = 1    -- reduced from 40
+    -- Sweep/slam stats live on the shared archetype
+    w.archetype   = Archetypes.mace
 
     -- Pending damage queue (damage applied at end of animation)
     w.pendingDamage = {}
 
+    -- Pending area effects, applied with the damage
+    w.pendingAreas = {}
+
     return w
 end
 
@@ -26,6 +28,19 @@ function Mace:queueDamage(enemy, damage, delay)
     })
 end
 
+-- Queue a status effect over an area, applied in one batch
+function Mace:queueArea(effects, name, x, y, radius, enemies, delay)
+    table.insert(self.pendingAreas, {
+        effects = effects,
+        name = name,
+        x = x,
+        y = y,
+        radius = radius,
+        enemies = enemies,
+        timer = delay
+    })
+end
+
 -- Process pending damage (call from update)
 function Mace:processPendingDamage(dt, sounds, Audio)
     for i = #self.pendingDamage, 1, -1 do
@@ -49,15 +64,26 @@ function Mace:processPendingDamage(dt, sounds, Audio)
             table.remove(self.pendingDamage, i)
         end
     end
+
+    -- After direct damage, so enemies it killed are skipped
+    for i = #self.pendingAreas, 1, -1 do
+        local pa = self.pendingAreas[i]
+        pa.timer = pa.timer - dt
+        if pa.timer <= 0 then
+            pa.effects:applyArea(pa.name, pa.x, pa.y, pa.radius, pa.enemies)
+            table.remove(self.pendingAreas, i)
+        end
+    end
 end
 
 function Mace:primary(enemies)
     if self.cooldown > 0 then return false end
-    self.cooldown = 2.0  -- Match animation duration
+    local sweep = self.archetype.sweep
+    self.cooldown = sweep.duration  -- Match animation duration
 
     self.anim.type = "sweep"
-    self.anim.timer = 2.0      -- 20 frames × 0.1s = 2s
-    self.anim.duration = 2.0
+    self.anim.timer = sweep.duration
+    self.anim.duration = sweep.duration
 
     local px, py = self.owner.x, self.owner.y
     local aim = self.owner.aim
@@ -69,11 +95,11 @@ function Mace:primary(enemies)
         local dy = enemy.y - py
         local dist = math.sqrt(dx * dx + dy * dy)
 
-        if dist <= self.sweepRange then
+        if dist <= sweep.range then
             local dot = dx * aim.x + dy * aim.y
-            if dot > 0.4 then
+            if dot > sweep.minDot then
                 -- Queue damage for 70% through animation (last 30% for hit/death anim)
-                self:queueDamage(enemy, self.sweepDamage, self.anim.duration * 0.7)
+                self:queueDamage(enemy, sweep.damage, self.anim.duration * self.archetype.damageDelay)
             end
         end
 
@@ -82,13 +108,14 @@ function Mace:primary(enemies)
     return true
 end
 
-function Mace:secondary(enemies)
+function Mace:secondary(enemies, effects)
     if self.cooldown > 0 then return false end
-    self.cooldown = 2.4  -- Match animation duration
+    local slam = self.archetype.slam
+    self.cooldown = slam.duration  -- Match animation duration
 
     self.anim.type = "slam"
-    self.anim.timer = 2.4      -- 24 frames × 0.1s = 2.4s
-    self.anim.duration = 2.4
+    self.anim.timer = slam.duration
+    self.anim.duration = slam.duration
 
     local px, py = self.owner.x, self.owner.y
 
@@ -99,13 +126,18 @@ function Mace:secondary(enemies)
         local dy = enemy.y - py
         local dist = math.sqrt(dx * dx + dy * dy)
 
-        if dist <= self.slamRadius then
+        if dist <= slam.radius then
             -- Queue damage for 70% through animation (last 30% for hit/death anim)
-            self:queueDamage(enemy, self.slamDamage, self.anim.duration * 0.7)
+            self:queueDamage(enemy, slam.damage, self.anim.duration * self.archetype.damageDelay)
         end
 
         ::continue::
     end
+
+    if effects and self.archetype.slamEffect then
+        self:queueArea(effects, self.archetype.slamEffect, px, py, slam.radius, enemies,
+            self.anim.duration * self.archetype.damageDelay)
+    end
     return true
 end
 
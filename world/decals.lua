@@ -0,0 +1,125 @@
+-- Persistent ground layer for corpses and splats.
+-- Finished death animations are stamped into world-space canvases tiled
+-- in chunks, after which the entity itself can be freed. Drawing the
+-- layer costs one textured quad per visible chunk, however many corpses
+-- it holds. Coordinates are iso-projected world pixels (no camera).
+local RenderQueue = require("core.render_queue")
+local Quality = require("core.quality")
+local Memory = require("core.memory")
+
+local Decals = {}
+Decals.__index = Decals
+
+local CHUNK_SIZE = 1024
+
+local SPLAT_COLORS = {
+    blood  = { 0.45, 0.02, 0.03, 0.55 },
+    scorch = { 0.08, 0.06, 0.05, 0.50 },
+}
+
+function Decals.new(chunkSize)
+    local self = setmetatable({}, Decals)
+
+    self.chunkSize = chunkSize or CHUNK_SIZE
+    self.chunks = {}     -- key -> chunk
+    self.chunkList = {}  -- stable iteration order for drawing
+    self.stamps = 0
+
+    return self
+end
+
+local function chunkKey(cx, cy)
+    return (cy + 32768) * 65536 + (cx + 32768)
+end
+
+function Decals:getChunk(cx, cy)
+    local key = chunkKey(cx, cy)
+    local chunk = self.chunks[key]
+    if not chunk then
+        chunk = {
+            x = cx * self.chunkSize,
+            y = cy * self.chunkSize,
+            canvas = love.graphics.newCanvas(self.chunkSize, self.chunkSize),
+        }
+        self.chunks[key] = chunk
+        self.chunkList[#self.chunkList + 1] = chunk
+        Memory.trackTexture(string.format("decals chunk %d,%d", cx, cy), chunk.canvas, "canvases")
+    end
+    return chunk
+end
+
+-- Run `paint(ox, oy)` on every chunk overlapping the given world-pixel
+-- rect, with (ox, oy) the offset from world pixels to that chunk's canvas
+function Decals:paint(x0, y0, x1, y1, paint)
+    local size = self.chunkSize
+
+    love.graphics.push("all")
+    love.graphics.origin()
+
+    for cy = math.floor(y0 / size), math.floor(y1 / size) do
+        for cx = math.floor(x0 / size), math.floor(x1 / size) do
+            local chunk = self:getChunk(cx, cy)
+            love.graphics.setCanvas(chunk.canvas)
+            paint(-chunk.x, -chunk.y)
+        end
+    end
+
+    love.graphics.pop()
+    self.stamps = self.stamps + 1
+end
+
+-- Overlapping ellipses, as many as the particle budget allows;
+-- `kind` is "blood" or "scorch"
+function Decals:splat(wx, wy, radius, kind)
+    local color = SPLAT_COLORS[kind] or SPLAT_COLORS.blood
+    local blobs = {}
+    for i = 1, Quality.settings.particleBudget do
+        blobs[i] = {
+            dx = (love.math.random() - 0.5) * radius,
+            dy = (love.math.random() - 0.5) * radius * 0.5,
+            r = radius * (0.35 + love.math.random() * 0.35),
+        }
+    end
+
+    self:paint(wx - radius * 1.5, wy - radius, wx + radius * 1.5, wy + radius, function(ox, oy)
+        love.graphics.setColor(color)
+        for _, b in ipairs(blobs) do
+            love.graphics.ellipse("fill", wx + ox + b.dx, wy + oy + b.dy, b.r, b.r * 0.5)
+        end
+    end)
+end
+
+-- Bake an enemy's current (final) frame plus a blood splat
+function Decals:stampEnemy(enemy, iso)
+    local wx, wy = iso(enemy.x, enemy.y)
+    local scale = enemy.archetype.spriteScale
+
+    self:splat(wx, wy + 20, 40, "blood")
+
+    local spritesheet, quad = enemy:getSprite()
+    if not (spritesheet and quad) then return end
+
+    local _, _, frameW, frameH = quad:getViewport()
+    local hw, hh = frameW * scale / 2, frameH * scale / 2
+
+    self:paint(wx - hw, wy - hh, wx + hw, wy + hh, function(ox, oy)
+        love.graphics.setColor(1, 1, 1, 1)
+        love.graphics.draw(spritesheet, quad, wx + ox, wy + oy, 0, scale, scale,
+            frameW / 2, frameH / 2)
+    end)
+end
+
+-- One sprite command per chunk; the queue culls chunks outside each view
+function Decals:draw(queue)
+    -- Canvases hold premultiplied color after alpha blending into them
+    queue:setColor(1, 1, 1, 1)
+    queue:setBlendMode("alpha", "premultiplied")
+
+    for _, chunk in ipairs(self.chunkList) do
+        queue:sprite(RenderQueue.LAYER_DECALS, 0, chunk.canvas, nil, chunk.x, chunk.y)
+    end
+
+    queue:setBlendMode("alpha")
+end
+
+return Decals
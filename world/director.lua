@@ -0,0 +1,203 @@
+-- Spawn director: runs waves of enemies and keeps their cost in budget.
+-- Main reports how long enemy simulation and rendering took each frame;
+-- the director keeps rolling per-enemy costs and, once per adapt
+-- interval, re-derives the spawn rate, the cap on concurrent enemies and
+-- the LOD/impostor distances from how much of the budget is left. Every
+-- change is logged.
+local GC = require("core.gc")
+
+local Director = {}
+Director.__index = Director
+
+Director.config = {
+    budgetMs = 6,              -- enemy sim + render per frame
+    adaptInterval = 1.0,       -- seconds between decisions
+    costSmoothing = 0.05,      -- EMA weight per frame
+    minConcurrent = 4,
+    maxConcurrent = 400,       -- hard cap, whatever the budget says
+    minSpawnDistance = 4,      -- tiles from the player
+    breather = 3,              -- seconds between waves
+
+    -- Distances in tiles from the player
+    lodDistance = 6,           -- beyond: no AI (facing) updates
+    impostorDistance = 7,      -- beyond: one shared sprite, batches
+    minDistance = 2,
+    maxDistance = 12,
+
+    waves = {
+        { count = 4, rate = 1 },
+        { count = 10, rate = 2 },
+        { count = 24, rate = 4 },
+        { count = 60, rate = 8 },
+        { count = 150, rate = 16 },
+    },
+}
+
+function Director.new(room, spawn)
+    local self = setmetatable({}, Director)
+    local config = Director.config
+
+    self.room = room
+    self.spawn = spawn  -- spawn(x, y) creates and registers an enemy
+
+    self.wave = 0
+    self.toSpawn = 0
+    self.spawnAccum = 0
+    self.breather = 0
+    self.finished = false
+
+    -- Rolling ms per live enemy
+    self.simCost = 0
+    self.renderCost = 0
+
+    -- Adapted knobs
+    self.maxConcurrent = config.maxConcurrent
+    self.spawnRate = 0
+    self.lodDistance = config.lodDistance
+    self.impostorDistance = config.impostorDistance
+
+    self.adaptTimer = 0
+    self.decisions = 0
+
+    self:startWave(1)
+    return self
+end
+
+function Director:log(fmt, ...)
+    self.decisions = self.decisions + 1
+    print(string.format("Director [%.1fs] " .. fmt, love.timer.getTime(), ...))
+end
+
+function Director:startWave(n)
+    local wave = Director.config.waves[n]
+    self.wave = n
+    self.toSpawn = wave.count
+    self.spawnRate = wave.rate
+    -- Spawn the first enemy straight away
+    self.spawnAccum = 1
+    self:log("wave %d: %d enemies at %.1f/s", n, wave.count, wave.rate)
+    GC.breakpoint("wave")
+end
+
+local function ema(old, sample, w)
+    if old == 0 then return sample end
+    return old + (sample - old) * w
+end
+
+-- Frame cost samples from main; `count` enemies contributed to `ms`
+function Director:recordSim(ms, count)
+    if count > 0 then
+        self.simCost = ema(self.simCost, ms / count, Director.config.costSmoothing)
+    end
+end
+
+function Director:recordRender(ms, count)
+    if count > 0 then
+        self.renderCost = ema(self.renderCost, ms / count, Director.config.costSmoothing)
+    end
+end
+
+function Director:isFinished()
+    return self.finished
+end
+
+-- Re-derive the knobs from the rolling costs
+function Director:adapt(live)
+    local config = Director.config
+    local perEnemy = self.simCost + self.renderCost
+    if perEnemy <= 0 then return end
+
+    local used = perEnemy * live
+    local headroom = (config.budgetMs - used) / config.budgetMs
+
+    -- Cap: as many as the budget holds at the current per-enemy cost
+    local cap = math.floor(config.budgetMs / perEnemy)
+    cap = math.max(config.minConcurrent, math.min(config.maxConcurrent, cap))
+    if math.abs(cap - self.maxConcurrent) > self.maxConcurrent * 0.1 then
+        self:log("max concurrent %d -> %d (%.4f ms/enemy: sim %.4f, render %.4f)",
+            self.maxConcurrent, cap, perEnemy, self.simCost, self.renderCost)
+        self.maxConcurrent = cap
+    end
+
+    -- Spawn rate scales with the headroom left in the budget
+    local waveRate = config.waves[self.wave].rate
+    local rate = waveRate * math.max(0.1, math.min(1, headroom))
+    if math.abs(rate - self.spawnRate) > 0.05 * waveRate then
+        self:log("spawn rate %.2f -> %.2f/s (%d live, %.2f of %.2f ms used)",
+            self.spawnRate, rate, live, used, config.budgetMs)
+        self.spawnRate = rate
+    end
+
+    -- Pull the LOD/impostor distances in when over budget, push them out
+    -- again once there's room
+    local step = 0
+    if headroom < 0 then
+        step = -1
+    elseif headroom > 0.4 then
+        step = 1
+    end
+    if step ~= 0 then
+        local lod = math.max(config.minDistance, math.min(config.maxDistance, self.lodDistance + step))
+        local imp = math.max(config.minDistance, math.min(config.maxDistance, self.impostorDistance + step))
+        if lod ~= self.lodDistance or imp ~= self.impostorDistance then
+            self:log("lod %d -> %d, impostor %d -> %d tiles (headroom %.0f%%)",
+                self.lodDistance, lod, self.impostorDistance, imp, headroom * 100)
+            self.lodDistance, self.impostorDistance = lod, imp
+        end
+    end
+end
+
+-- A random walkable tile at least minSpawnDistance from the player
+function Director:pickTile(player)
+    local minDist2 = Director.config.minSpawnDistance ^ 2
+    local x, y
+    for _ = 1, 10 do
+        x, y = self.room:getRandomTile()
+        local dx, dy = x - player.x, y - player.y
+        if dx * dx + dy * dy >= minDist2 then break end
+    end
+    return x, y
+end
+
+function Director:update(dt, player, live)
+    if self.finished then return end
+
+    self.adaptTimer = self.adaptTimer + dt
+    if self.adaptTimer >= Director.config.adaptInterval then
+        self.adaptTimer = 0
+        self:adapt(live)
+    end
+
+    if self.toSpawn > 0 then
+        self.spawnAccum = self.spawnAccum + dt * self.spawnRate
+        while self.spawnAccum >= 1 and self.toSpawn > 0 do
+            if live >= self.maxConcurrent then
+                -- Hold the backlog until enemies die
+                self.spawnAccum = 1
+                break
+            end
+            self.spawnAccum = self.spawnAccum - 1
+            self.toSpawn = self.toSpawn - 1
+            self.spawn(self:pickTile(player))
+            live = live + 1
+        end
+        return
+    end
+
+    -- Wave fully spawned: wait for it to be cleared, then a breather
+    if live > 0 then return end
+
+    if self.wave >= #Director.config.waves then
+        self.finished = true
+        self:log("all %d waves cleared", self.wave)
+        return
+    end
+
+    self.breather = self.breather + dt
+    if self.breather >= Director.config.breather then
+        self.breather = 0
+        self:startWave(self.wave + 1)
+    end
+end
+
+return Director
@@ -0,0 +1,193 @@
+-- Room floor baked into static meshes.
+-- Built once per room (and again when the map changes) in iso-projected
+-- pixels and shared by every view: one draw for the fills and, in
+-- "outlined" mode, one for the grid lines. With a Visibility attached, a
+-- dynamic fog mesh darkens tiles the player can't see; only tiles whose
+-- fog state changed get their vertex colors rewritten.
+local ffi = require("ffi")
+local Iso = require("core.iso")
+local RenderQueue = require("core.render_queue")
+local Memory = require("core.memory")
+
+local Floor = {}
+Floor.__index = Floor
+
+local GRID_FILL  = { 84 / 255, 225 / 255, 227 / 255 }
+local GRID_LINE  = { 84 / 255, 225 / 255, 227 / 255 }
+local LINE_ALPHA = 0.35
+local LINE_WIDTH = 1
+
+-- Fog alpha per tile state
+local FOG_UNSEEN  = 0.85
+local FOG_SEEN    = 0.5
+local FOG_VISIBLE = 0
+local FOG_ALPHA = { [0] = FOG_UNSEEN, FOG_SEEN, FOG_VISIBLE }
+
+function Floor.new(room, tileW, tileH, mode)
+    local self = setmetatable({}, Floor)
+
+    self.room = room
+    self.tileW = tileW
+    self.tileH = tileH
+    self.mode = mode or "outlined"  -- "outlined" or "flat"
+
+    self:build()
+
+    -- Rebuilt lazily on the next draw after any tile changes
+    room:onChange(function() self.dirty = true end)
+
+    return self
+end
+
+local function addTri(v, x1, y1, x2, y2, x3, y3, r, g, b, a)
+    local n = #v
+    v[n + 1] = { x1, y1, 0, 0, r, g, b, a }
+    v[n + 2] = { x2, y2, 0, 0, r, g, b, a }
+    v[n + 3] = { x3, y3, 0, 0, r, g, b, a }
+end
+
+-- Thin quad standing in for a 1px line from (ax, ay) to (bx, by)
+local function addEdge(v, ax, ay, bx, by, r, g, b, a)
+    local dx, dy = bx - ax, by - ay
+    local len = math.sqrt(dx * dx + dy * dy)
+    local nx, ny = -dy / len * LINE_WIDTH / 2, dx / len * LINE_WIDTH / 2
+
+    addTri(v, ax + nx, ay + ny, bx + nx, by + ny, bx - nx, by - ny, r, g, b, a)
+    addTri(v, ax + nx, ay + ny, bx - nx, by - ny, ax - nx, ay - ny, r, g, b, a)
+end
+
+function Floor:build()
+    local room = self.room
+    local tw, th = self.tileW, self.tileH
+    local fill, line = {}, {}
+
+    for y = 1, room.h do
+        for x = 1, room.w do
+            if room.map[y][x] then
+                local sx, sy = Iso.project(x - 1, y - 1, tw, th)
+
+                local p1x, p1y = sx, sy
+                local p2x, p2y = sx + tw / 2, sy + th / 2
+                local p3x, p3y = sx, sy + th
+                local p4x, p4y = sx - tw / 2, sy + th / 2
+
+                local alpha = 0.08 + (y / room.h) * 0.10
+                local r, g, b = GRID_FILL[1], GRID_FILL[2], GRID_FILL[3]
+                addTri(fill, p1x, p1y, p2x, p2y, p3x, p3y, r, g, b, alpha)
+                addTri(fill, p1x, p1y, p3x, p3y, p4x, p4y, r, g, b, alpha)
+
+                if self.mode == "outlined" then
+                    r, g, b = GRID_LINE[1], GRID_LINE[2], GRID_LINE[3]
+                    addEdge(line, p1x, p1y, p2x, p2y, r, g, b, LINE_ALPHA)
+                    addEdge(line, p2x, p2y, p3x, p3y, r, g, b, LINE_ALPHA)
+                    addEdge(line, p3x, p3y, p4x, p4y, r, g, b, LINE_ALPHA)
+                    addEdge(line, p4x, p4y, p1x, p1y, r, g, b, LINE_ALPHA)
+                end
+            end
+        end
+    end
+
+    if self.fillMesh then Memory.untrack(self.fillMesh); self.fillMesh:release() end
+    if self.lineMesh then Memory.untrack(self.lineMesh); self.lineMesh:release() end
+
+    self.fillMesh = #fill > 0 and love.graphics.newMesh(fill, "triangles", "static") or nil
+    self.lineMesh = #line > 0 and love.graphics.newMesh(line, "triangles", "static") or nil
+    if self.fillMesh then Memory.trackMesh("floor fill", self.fillMesh) end
+    if self.lineMesh then Memory.trackMesh("floor lines", self.lineMesh) end
+
+    if self.visibility then self:buildFog() end
+end
+
+function Floor:setVisibility(visibility)
+    self.visibility = visibility
+    self:buildFog()
+end
+
+-- One dark diamond per walkable tile, all starting unseen
+function Floor:buildFog()
+    local room = self.room
+    local tw, th = self.tileW, self.tileH
+    local verts = {}
+
+    -- First fog vertex of each tile (0 = no fog quad), and its fog state
+    self.fogVertex = ffi.new("int32_t[?]", room.w * room.h)
+    self.fogState = ffi.new("uint8_t[?]", room.w * room.h)
+
+    for y = 1, room.h do
+        for x = 1, room.w do
+            if room.map[y][x] then
+                local sx, sy = Iso.project(x - 1, y - 1, tw, th)
+                self.fogVertex[(y - 1) * room.w + (x - 1)] = #verts + 1
+                addTri(verts, sx, sy, sx + tw / 2, sy + th / 2, sx, sy + th, 0, 0, 0, FOG_UNSEEN)
+                addTri(verts, sx, sy, sx, sy + th, sx - tw / 2, sy + th / 2, 0, 0, 0, FOG_UNSEEN)
+            end
+        end
+    end
+
+    if self.fogMesh then Memory.untrack(self.fogMesh); self.fogMesh:release() end
+    self.fogMesh = #verts > 0 and love.graphics.newMesh(verts, "triangles", "dynamic") or nil
+    if self.fogMesh then Memory.trackMesh("floor fog", self.fogMesh) end
+
+    -- Force a full refresh against the current visibility
+    self.fogVersion = nil
+    self.fogFull = true
+end
+
+-- Rewrite vertex colors for tiles in the visibility's changed rect
+function Floor:updateFog()
+    local vis = self.visibility
+    if not self.fogMesh or self.fogVersion == vis.version then return end
+
+    local room = self.room
+    -- changed* only covers the latest recompute; if any were missed (no
+    -- draw in between: hidden window, several updates per draw), refresh
+    -- everything. Unchanged tiles cost a compare, not a vertex write.
+    local x0, y0, x1, y1 = vis.changedX0, vis.changedY0, vis.changedX1, vis.changedY1
+    if self.fogFull or self.fogVersion ~= vis.version - 1 then
+        x0, y0, x1, y1 = 1, 1, room.w, room.h
+        self.fogFull = false
+    end
+
+    local mesh = self.fogMesh
+    for y = y0, y1 do
+        for x = x0, x1 do
+            local i = (y - 1) * room.w + (x - 1)
+            local first = self.fogVertex[i]
+            if first > 0 then
+                local state = vis:isVisible(x, y) and 2 or (vis:isSeen(x, y) and 1 or 0)
+                if state ~= self.fogState[i] then
+                    self.fogState[i] = state
+                    local alpha = FOG_ALPHA[state]
+                    for v = first, first + 5 do
+                        mesh:setVertexAttribute(v, 3, 0, 0, 0, alpha)
+                    end
+                end
+            end
+        end
+    end
+
+    self.fogVersion = vis.version
+end
+
+function Floor:draw(queue)
+    if self.dirty then
+        self.dirty = false
+        self:build()
+    end
+
+    queue:setColor(1, 1, 1, 1)
+    if self.fillMesh then
+        queue:sprite(RenderQueue.LAYER_FLOOR, 0, self.fillMesh, nil, 0, 0)
+    end
+    if self.lineMesh then
+        queue:sprite(RenderQueue.LAYER_FLOOR, 1, self.lineMesh, nil, 0, 0)
+    end
+
+    -- Above decals and blob shadows, below entities
+    if self.visibility and self.fogMesh then
+        self:updateFog()
+        queue:sprite(RenderQueue.LAYER_DECALS, 2, self.fogMesh, nil, 0, 0)
+    end
+end
+
+return Floor
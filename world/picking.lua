@@ -0,0 +1,53 @@
+-- Cursor picking of entities by their drawn sprite, not their ground point.
+-- A sprite is drawn centered on its iso-projected ground point, so the
+-- cursor can be over an entity standing well below it on screen. Every
+-- ground point whose trimmed sprite rect can contain the cursor lies in a
+-- band along the cursor's screen column; that band's world bounding box
+-- is queried from the spatial hash and only those candidates are tested.
+local Iso = require("core.iso")
+
+local Picking = {}
+
+local candidates = {}
+
+-- Screen-pixel rect of the archetype's opaque area, relative to the
+-- ground point: left, top, right, bottom
+function Picking.spriteRect(arch)
+    local b = arch.pickBounds
+    local half = arch.pickFrame / 2
+    local s = arch.spriteScale
+    return (b[1] - half) * s, (b[2] - half) * s, (b[3] - half) * s, (b[4] - half) * s
+end
+
+-- Topmost live entity under world-pixel point (px, py), or nil.
+-- All entities in `hash` are assumed to share `arch`.
+function Picking.pick(hash, arch, px, py, tileW, tileH)
+    local left, top, right, bottom = Picking.spriteRect(arch)
+
+    -- Ground points that can contain the cursor, as ranges of u = x - y
+    -- and v = x + y, then as a world AABB for the hash query
+    local u0, u1 = (px - right) / (tileW / 2), (px - left) / (tileW / 2)
+    local v0, v1 = (py - bottom) / (tileH / 2), (py - top) / (tileH / 2)
+    local x0, x1 = (u0 + v0) / 2, (u1 + v1) / 2
+    local y0, y1 = (v0 - u1) / 2, (v1 - u0) / 2
+
+    local n = hash:query(x0, y0, x1, y1, candidates)
+
+    -- Depth order matches the render queue: larger x + y is drawn on top
+    local best, bestDepth = nil, -math.huge
+    for i = 1, n do
+        local e = candidates[i]
+        local depth = e.x + e.y
+        if not e.dead and depth > bestDepth then
+            local sx, sy = Iso.project(e.x, e.y, tileW, tileH)
+            local dx, dy = px - sx, py - sy
+            if dx >= left and dx <= right and dy >= top and dy <= bottom then
+                best, bestDepth = e, depth
+            end
+        end
+    end
+
+    return best
+end
+
+return Picking
@@ -7,10 +7,26 @@ function Room.new(w, h)
     self.w = w
     self.h = h
     self.map = {}
+    self.listeners = {}
 
     return self
 end
 
+-- fn(x, y) is called with 1-based tile coords whenever a tile changes
+function Room:onChange(fn)
+    table.insert(self.listeners, fn)
+end
+
+function Room:setWalkable(x, y, walkable)
+    if not self.map[y] or self.map[y][x] == nil then return end
+    if self.map[y][x] == walkable then return end
+
+    self.map[y][x] = walkable
+    for _, fn in ipairs(self.listeners) do
+        fn(x, y)
+    end
+end
+
 function Room:generate()
     local cx, cy = self.w / 2, self.h / 2
     local baseRadius = math.min(self.w, self.h) * 0.35
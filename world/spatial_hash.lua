@@ -0,0 +1,84 @@
+-- Uniform grid over world coords for "what's near here" queries.
+-- Objects are bucketed by the cell containing their (x, y); update() only
+-- touches the buckets when an object crosses into a new cell.
+local SpatialHash = {}
+SpatialHash.__index = SpatialHash
+
+function SpatialHash.new(cellSize)
+    local self = setmetatable({}, SpatialHash)
+
+    self.cellSize = cellSize or 2
+    self.cells = {}   -- key -> array of objects
+    self.cellOf = {}  -- object -> key
+    self.count = 0
+
+    return self
+end
+
+local function cellKey(cx, cy)
+    return (cy + 32768) * 65536 + (cx + 32768)
+end
+
+function SpatialHash:keyFor(x, y)
+    local size = self.cellSize
+    return cellKey(math.floor(x / size), math.floor(y / size))
+end
+
+function SpatialHash:insert(obj, x, y)
+    local key = self:keyFor(x, y)
+    local cell = self.cells[key]
+    if not cell then
+        cell = {}
+        self.cells[key] = cell
+    end
+    cell[#cell + 1] = obj
+    self.cellOf[obj] = key
+    self.count = self.count + 1
+end
+
+function SpatialHash:remove(obj)
+    local key = self.cellOf[obj]
+    if not key then return end
+
+    local cell = self.cells[key]
+    for i = 1, #cell do
+        if cell[i] == obj then
+            cell[i] = cell[#cell]
+            cell[#cell] = nil
+            break
+        end
+    end
+    self.cellOf[obj] = nil
+    self.count = self.count - 1
+end
+
+function SpatialHash:update(obj, x, y)
+    local key = self:keyFor(x, y)
+    if key == self.cellOf[obj] then return end
+    self:remove(obj)
+    self:insert(obj, x, y)
+end
+
+-- Objects in cells overlapping the world rect, written to `out`; returns
+-- the count (candidates only, callers do the exact test)
+function SpatialHash:query(x0, y0, x1, y1, out)
+    local size = self.cellSize
+    local n = 0
+
+    for cy = math.floor(y0 / size), math.floor(y1 / size) do
+        for cx = math.floor(x0 / size), math.floor(x1 / size) do
+            local cell = self.cells[cellKey(cx, cy)]
+            if cell then
+                for i = 1, #cell do
+                    n = n + 1
+                    out[n] = cell[i]
+                end
+            end
+        end
+    end
+
+    for i = #out, n + 1, -1 do out[i] = nil end
+    return n
+end
+
+return SpatialHash
@@ -0,0 +1,167 @@
+-- Tile visibility from the player, by recursive shadowcasting.
+-- Results live in bitfields (one bit per tile): `visible` for this
+-- recompute and `seen` for everything ever visible. Recomputation only
+-- happens when the player enters a new tile or the room's walls change;
+-- `version` bumps each time so consumers (floor fog, AI) can tell.
+local ffi = require("ffi")
+local bit = require("bit")
+
+local band, bor, lshift, rshift = bit.band, bit.bor, bit.lshift, bit.rshift
+
+local Visibility = {}
+Visibility.__index = Visibility
+
+-- Octant transforms: x' = dx*xx + dy*xy, y' = dx*yx + dy*yy
+local OCTANTS = {
+    { 1, 0, 0, 1 }, { 0, 1, 1, 0 }, { 0, -1, 1, 0 }, { -1, 0, 0, 1 },
+    { -1, 0, 0, -1 }, { 0, -1, -1, 0 }, { 0, 1, -1, 0 }, { 1, 0, 0, -1 },
+}
+
+function Visibility.new(room, radius)
+    local self = setmetatable({}, Visibility)
+
+    self.room = room
+    self.radius = radius or 8
+
+    self.words = math.ceil(room.w * room.h / 32)
+    self.visible = ffi.new("uint32_t[?]", self.words)
+    self.seen = ffi.new("uint32_t[?]", self.words)
+
+    self.tileX, self.tileY = nil, nil
+    self.version = 0
+
+    -- Tile rect (inclusive) whose state may differ from the last version
+    self.changedX0, self.changedY0, self.changedX1, self.changedY1 = 1, 1, room.w, room.h
+
+    self.dirty = true
+    room:onChange(function() self.dirty = true end)
+
+    return self
+end
+
+local function setBit(field, i)
+    local w = rshift(i, 5)
+    field[w] = bor(field[w], lshift(1, band(i, 31)))
+end
+
+local function getBit(field, i)
+    return band(field[rshift(i, 5)], lshift(1, band(i, 31))) ~= 0
+end
+
+-- 1-based tile coords
+function Visibility:isVisible(x, y)
+    local room = self.room
+    if x < 1 or y < 1 or x > room.w or y > room.h then return false end
+    return getBit(self.visible, (y - 1) * room.w + (x - 1))
+end
+
+function Visibility:isSeen(x, y)
+    local room = self.room
+    if x < 1 or y < 1 or x > room.w or y > room.h then return false end
+    return getBit(self.seen, (y - 1) * room.w + (x - 1))
+end
+
+-- World coords (same space as entity x/y)
+function Visibility:canSee(wx, wy)
+    return self:isVisible(math.floor(wx) + 1, math.floor(wy) + 1)
+end
+
+function Visibility:reveal(x, y)
+    local room = self.room
+    if x < 1 or y < 1 or x > room.w or y > room.h then return end
+    local i = (y - 1) * room.w + (x - 1)
+    setBit(self.visible, i)
+    setBit(self.seen, i)
+end
+
+function Visibility:blocks(x, y)
+    local row = self.room.map[y]
+    return not (row and row[x])
+end
+
+-- Scan one octant row by row, narrowing [start, finish] slopes as walls
+-- are found and recursing past each wall run
+function Visibility:castLight(cx, cy, row, start, finish, xx, xy, yx, yy)
+    if start < finish then return end
+
+    local radius = self.radius
+    local radius2 = radius * radius
+    local newStart = 0
+
+    for j = row, radius do
+        local dy = -j
+        local blocked = false
+
+        for dx = -j, 0 do
+            local x = cx + dx * xx + dy * xy
+            local y = cy + dx * yx + dy * yy
+            local leftSlope = (dx - 0.5) / (dy + 0.5)
+            local rightSlope = (dx + 0.5) / (dy - 0.5)
+
+            if start < rightSlope then
+                goto continue
+            elseif finish > leftSlope then
+                break
+            end
+
+            if dx * dx + dy * dy <= radius2 then
+                self:reveal(x, y)
+            end
+
+            if blocked then
+                if self:blocks(x, y) then
+                    newStart = rightSlope
+                else
+                    blocked = false
+                    start = newStart
+                end
+            elseif self:blocks(x, y) and j < radius then
+                blocked = true
+                self:castLight(cx, cy, j + 1, start, leftSlope, xx, xy, yx, yy)
+                newStart = rightSlope
+            end
+
+            ::continue::
+        end
+
+        if blocked then break end
+    end
+end
+
+-- Recompute unconditionally from tile (x, y)
+function Visibility:compute(x, y)
+    ffi.fill(self.visible, self.words * 4)
+
+    self:reveal(x, y)
+    for _, o in ipairs(OCTANTS) do
+        self:castLight(x, y, 1, 1.0, 0.0, o[1], o[2], o[3], o[4])
+    end
+end
+
+-- Recompute if the player changed tile or the walls changed; returns true
+-- when the bitfields were updated
+function Visibility:update(wx, wy)
+    local x, y = math.floor(wx) + 1, math.floor(wy) + 1
+    if not self.dirty and x == self.tileX and y == self.tileY then
+        return false
+    end
+
+    local room, r = self.room, self.radius
+    if self.dirty or not self.tileX then
+        self.changedX0, self.changedY0, self.changedX1, self.changedY1 = 1, 1, room.w, room.h
+    else
+        -- Union of the old and new radius boxes
+        self.changedX0 = math.max(1, math.min(self.tileX, x) - r)
+        self.changedY0 = math.max(1, math.min(self.tileY, y) - r)
+        self.changedX1 = math.min(room.w, math.max(self.tileX, x) + r)
+        self.changedY1 = math.min(room.h, math.max(self.tileY, y) + r)
+    end
+
+    self.tileX, self.tileY = x, y
+    self.dirty = false
+    self:compute(x, y)
+    self.version = self.version + 1
+    return true
+end
+
+return Visibility
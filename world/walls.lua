@@ -0,0 +1,185 @@
+-- Raised wall blocks with occlusion fading.
+-- Every blocking tile that borders a walkable one (room edges, pillars)
+-- is drawn as an iso block sharing one unit mesh, depth-sorted with the
+-- entities by x + y. Blocks are bucketed once by their screen-space rect
+-- (iso world pixels, camera independent); each frame only the buckets
+-- under each entity's sprite are scanned for blocks in front of it, and
+-- those fade toward translucent.
+local Iso = require("core.iso")
+local RenderQueue = require("core.render_queue")
+local Memory = require("core.memory")
+
+local Walls = {}
+Walls.__index = Walls
+
+local HEIGHT = 110          -- screen px a block rises above its tile
+local BUCKET = 256          -- screen-space bucket size in px
+local FADED_ALPHA = 0.3
+local FADE_SPEED = 6        -- alpha per second
+local DIM = 0.5             -- color of blocks seen but not in view
+
+local TOP   = { 0.20, 0.45, 0.47 }
+local LEFT  = { 0.12, 0.28, 0.30 }
+local RIGHT = { 0.09, 0.21, 0.23 }
+
+local NEIGHBORS = { { -1, -1 }, { 0, -1 }, { 1, -1 }, { -1, 0 }, { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } }
+
+function Walls.new(room, tileW, tileH, visibility)
+    local self = setmetatable({}, Walls)
+
+    self.room = room
+    self.tileW = tileW
+    self.tileH = tileH
+    self.visibility = visibility
+
+    self.mesh = self:buildMesh()
+    self:build()
+
+    room:onChange(function() self.dirty = true end)
+
+    return self
+end
+
+-- One block relative to its tile's top corner: top face plus the two
+-- faces that can face the camera
+function Walls:buildMesh()
+    local hw, th = self.tileW / 2, self.tileH
+    local v = {}
+    local function quad(c, x1, y1, x2, y2, x3, y3, x4, y4)
+        for _, p in ipairs({ { x1, y1 }, { x2, y2 }, { x3, y3 }, { x1, y1 }, { x3, y3 }, { x4, y4 } }) do
+            table.insert(v, { p[1], p[2], 0, 0, c[1], c[2], c[3], 1 })
+        end
+    end
+
+    quad(LEFT, -hw, th / 2 - HEIGHT, 0, th - HEIGHT, 0, th, -hw, th / 2)
+    quad(RIGHT, 0, th - HEIGHT, hw, th / 2 - HEIGHT, hw, th / 2, 0, th)
+    quad(TOP, 0, -HEIGHT, hw, th / 2 - HEIGHT, 0, th - HEIGHT, -hw, th / 2 - HEIGHT)
+
+    local mesh = love.graphics.newMesh(v, "triangles", "static")
+    Memory.trackMesh("wall block", mesh)
+    return mesh
+end
+
+local function bucketKey(bx, by)
+    return (by + 32768) * 65536 + (bx + 32768)
+end
+
+function Walls:build()
+    local room = self.room
+    local hw, th = self.tileW / 2, self.tileH
+
+    -- Parallel arrays per block
+    self.tx, self.ty = {}, {}
+    self.sx, self.sy = {}, {}
+    self.depth = {}
+    self.alpha = {}
+    self.fade = {}
+    self.count = 0
+    self.buckets = {}
+
+    for y = 1, room.h do
+        for x = 1, room.w do
+            if not room.map[y][x] then
+                local exposed = false
+                for _, d in ipairs(NEIGHBORS) do
+                    local row = room.map[y + d[2]]
+                    if row and row[x + d[1]] then
+                        exposed = true
+                        break
+                    end
+                end
+
+                if exposed then
+                    local n = self.count + 1
+                    self.count = n
+
+                    local sx, sy = Iso.project(x - 1, y - 1, self.tileW, self.tileH)
+                    self.tx[n], self.ty[n] = x, y
+                    self.sx[n], self.sy[n] = sx, sy
+                    -- In front of anything standing north/west of it
+                    self.depth[n] = (x - 1) + (y - 1) + 1
+                    self.alpha[n] = 1
+                    self.fade[n] = false
+
+                    for by = math.floor((sy - HEIGHT) / BUCKET), math.floor((sy + th) / BUCKET) do
+                        for bx = math.floor((sx - hw) / BUCKET), math.floor((sx + hw) / BUCKET) do
+                            local key = bucketKey(bx, by)
+                            local bucket = self.buckets[key]
+                            if not bucket then
+                                bucket = {}
+                                self.buckets[key] = bucket
+                            end
+                            bucket[#bucket + 1] = n
+                        end
+                    end
+                end
+            end
+        end
+    end
+
+    self.dirty = false
+end
+
+-- Mark blocks in front of an entity whose sprite covers the screen rect
+-- (left, top, right, bottom) and whose depth is `depth`
+function Walls:occlude(left, top, right, bottom, depth)
+    local hw, th = self.tileW / 2, self.tileH
+    local sx, sy, blockDepth, fade = self.sx, self.sy, self.depth, self.fade
+
+    for by = math.floor(top / BUCKET), math.floor(bottom / BUCKET) do
+        for bx = math.floor(left / BUCKET), math.floor(right / BUCKET) do
+            local bucket = self.buckets[bucketKey(bx, by)]
+            if bucket then
+                for i = 1, #bucket do
+                    local n = bucket[i]
+                    if blockDepth[n] > depth
+                        and sx[n] + hw > left and sx[n] - hw < right
+                        and sy[n] + th > top and sy[n] - HEIGHT < bottom then
+                        fade[n] = true
+                    end
+                end
+            end
+        end
+    end
+end
+
+-- rects: flat array of left, top, right, bottom, depth per entity
+function Walls:update(dt, rects, count)
+    if self.dirty then self:build() end
+
+    local fade, alpha = self.fade, self.alpha
+    for i = 1, self.count do fade[i] = false end
+
+    for i = 0, count - 1 do
+        local o = i * 5
+        self:occlude(rects[o + 1], rects[o + 2], rects[o + 3], rects[o + 4], rects[o + 5])
+    end
+
+    local step = FADE_SPEED * dt
+    for i = 1, self.count do
+        local target = fade[i] and FADED_ALPHA or 1
+        local a = alpha[i]
+        if a < target then
+            alpha[i] = math.min(target, a + step)
+        elseif a > target then
+            alpha[i] = math.max(target, a - step)
+        end
+    end
+end
+
+function Walls:draw(queue)
+    local vis = self.visibility
+    local hw, th = self.tileW / 2, self.tileH
+
+    for i = 1, self.count do
+        local x, y = self.tx[i], self.ty[i]
+        if not vis or vis:isSeen(x, y) then
+            local c = (not vis or vis:isVisible(x, y)) and 1 or DIM
+            queue:setColor(c, c, c, self.alpha[i])
+            queue:mesh(RenderQueue.LAYER_ENTITIES, self.depth[i], self.mesh,
+                self.sx[i], self.sy[i], -hw, -HEIGHT, hw, th)
+        end
+    end
+end
+
+return Walls